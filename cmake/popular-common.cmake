@@ -1,7 +1,12 @@
 include_guard(GLOBAL)
 
 prepend(POPULAR_COMMON_SOURCES ${COMMON_DIR}/
+        algorithms/number-conversions.cpp
         algorithms/simd-int-to-string.cpp
+        algorithms/simd-numeric.cpp
+        algorithms/simd-utf8.cpp
+        algorithms/simd-url.cpp
+        algorithms/xxh3.cpp
         server/limits.cpp
         server/signals.cpp
         server/relogin.cpp
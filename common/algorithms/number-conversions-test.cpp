@@ -0,0 +1,128 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#include "common/algorithms/number-conversions.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace {
+double exact_power_for_test(uint64_t k) {
+  double res = 1;
+  while (k-- > 0) {
+    res *= 10;
+  }
+  return res;
+}
+
+std::string format_float_snprintf(double f) {
+  char buf[64];
+  const int len = snprintf(buf, sizeof(buf), "%.14G", f);
+  return {buf, static_cast<size_t>(len)};
+}
+
+// checks that the fast path either refuses or gives the same result as snprintf
+void check_format(double f, bool must_be_fast = false) {
+  char buf[32];
+  const size_t len = try_format_float_precision14(f, buf);
+  if (len == 0) {
+    ASSERT_FALSE(must_be_fast) << format_float_snprintf(f);
+    return;
+  }
+  ASSERT_LE(len, 20);
+  ASSERT_EQ(std::string(buf, len), format_float_snprintf(f));
+}
+
+void check_parse(const std::string &s, bool must_be_fast = false) {
+  double fast = 0;
+  if (!try_parse_simple_decimal(s.c_str(), s.size(), &fast)) {
+    ASSERT_FALSE(must_be_fast) << s;
+    return;
+  }
+  char *end = nullptr;
+  const double slow = strtod(s.c_str(), &end);
+  ASSERT_EQ(end, s.c_str() + s.size()) << s;
+  ASSERT_EQ(std::signbit(fast), std::signbit(slow)) << s;
+  ASSERT_EQ(fast, slow) << s;
+}
+} // namespace
+
+TEST(number_conversions, swar_digits) {
+  ASSERT_TRUE(are_8_digits(load_8_chars("01234567")));
+  ASSERT_TRUE(are_8_digits(load_8_chars("99999999")));
+  ASSERT_FALSE(are_8_digits(load_8_chars("0123456:")));
+  ASSERT_FALSE(are_8_digits(load_8_chars("/1234567")));
+  ASSERT_FALSE(are_8_digits(load_8_chars("1234 567")));
+  ASSERT_FALSE(are_8_digits(load_8_chars("\xff""1234567")));
+  ASSERT_EQ(parse_8_digits(load_8_chars("01234567")), 1234567);
+  ASSERT_EQ(parse_8_digits(load_8_chars("99999999")), 99999999);
+  ASSERT_EQ(parse_8_digits(load_8_chars("10000000")), 10000000);
+
+  std::mt19937_64 gen{42};
+  for (int i = 0; i < 100000; ++i) {
+    char buf[9];
+    const auto value = static_cast<uint32_t>(gen() % 100000000);
+    snprintf(buf, sizeof(buf), "%08u", value);
+    ASSERT_TRUE(are_8_digits(load_8_chars(buf)));
+    ASSERT_EQ(parse_8_digits(load_8_chars(buf)), value);
+    buf[gen() % 8] = static_cast<char>(gen() % 2 ? '0' + 10 + gen() % 200 : gen() % '0');
+    ASSERT_FALSE(are_8_digits(load_8_chars(buf))) << buf;
+  }
+
+  ASSERT_TRUE(are_all_digits("", 0));
+  ASSERT_TRUE(are_all_digits("1234567890123456789", 19));
+  ASSERT_FALSE(are_all_digits("123456789012345678x", 19));
+  ASSERT_FALSE(are_all_digits("12345678x", 9));
+}
+
+TEST(number_conversions, parse_simple_decimal) {
+  for (const char *s : {"0", "-0", "+0", "1", "-1", "0.5", "-0.0", ".5", "5.", "-.25", "123.456", "0.1", "0.3", "9007199254740991",
+                        "1234567890.123456", "0.0000000000000000000001"}) {
+    check_parse(s, true);
+  }
+  for (const char *s : {"", "-", "+", ".", "-.", "1e5", " 1", "1 ", "0x10", "inf", "nan", "1.2.3", "9007199254740993", "12345678901234567890",
+                        "0.00000000000000000000001", "1,5"}) {
+    double val = 0;
+    ASSERT_FALSE(try_parse_simple_decimal(s, strlen(s), &val)) << s;
+  }
+
+  std::mt19937_64 gen{42};
+  for (int i = 0; i < 1000000; ++i) {
+    std::string s = gen() % 4 == 0 ? "-" : "";
+    s += std::to_string(gen() % (gen() % 2 ? 1000 : 10000000000ULL));
+    if (gen() % 4) {
+      std::string fraction = std::to_string(gen() % 100000000000ULL);
+      fraction.resize(gen() % (fraction.size() + 1));
+      s += "." + fraction;
+    }
+    check_parse(s);
+  }
+}
+
+TEST(number_conversions, format_float_precision14) {
+  for (double f : {0.1, 0.5, -0.5, 1.5, 3.14, 123.456, 0.0001, 99999999999999.0, 1.0, -1.0, 100.0, 0.25, 1e13, 12345678.9}) {
+    check_format(f, true);
+  }
+  for (double f : {0.0, -0.0, 0.1 + 0.2, 1e14, 1e20, 0.00001, 1.0 / 3, double{NAN}, double{INFINITY}, -double{INFINITY}, 99999999999999.99, 0.000099999999999999}) {
+    check_format(f);
+  }
+
+  std::mt19937_64 gen{42};
+  std::uniform_real_distribution<double> exponent{-6, 16};
+  for (int i = 0; i < 1000000; ++i) {
+    // random doubles, short decimals (like prices) and decimals with exactly 14-15 digits
+    check_format(std::pow(10.0, exponent(gen)) * (gen() % 2 ? 1 : -1));
+    check_format(static_cast<double>(gen() % 100000000) / exact_power_for_test(gen() % 8));
+    check_format(static_cast<double>(10000000000000ULL + gen() % 990000000000000ULL) / exact_power_for_test(gen() % 23));
+    uint64_t bits = gen();
+    double raw = 0;
+    memcpy(&raw, &bits, sizeof(raw));
+    check_format(raw);
+  }
+}
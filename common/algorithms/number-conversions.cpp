@@ -0,0 +1,154 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#include "common/algorithms/number-conversions.h"
+
+#include <cmath>
+#include <iterator>
+
+#include "common/algorithms/simd-int-to-string.h"
+
+namespace {
+
+// all these powers of 10 are exactly representable as double
+constexpr double exact_powers_of_10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+                                         1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+constexpr uint64_t max_exact_mantissa = 1ULL << 53;
+
+constexpr int float_precision = 14;
+constexpr uint64_t min_precision_mantissa = 10000000000000ULL;  // 10^13
+constexpr uint64_t max_precision_mantissa = 100000000000000ULL; // 10^14
+
+// parses digits while they fit into the uint64_t mantissa, leading zeros are skipped;
+// returns the position of the first non-digit, or of the digit that doesn't fit
+size_t parse_digits(const char *s, size_t pos, size_t len, uint64_t *mantissa, size_t *significant_digits) noexcept {
+  if (*mantissa == 0) {
+    while (pos < len && s[pos] == '0') {
+      ++pos;
+    }
+  }
+  while (pos + 8 <= len && *significant_digits + 8 <= 19) {
+    const uint64_t chunk = load_8_chars(s + pos);
+    if (!are_8_digits(chunk)) {
+      break;
+    }
+    *mantissa = *mantissa * 100000000 + parse_8_digits(chunk);
+    *significant_digits += 8;
+    pos += 8;
+  }
+  while (pos < len && '0' <= s[pos] && s[pos] <= '9' && *significant_digits < 19) {
+    *mantissa = *mantissa * 10 + (s[pos] - '0');
+    ++*significant_digits;
+    ++pos;
+  }
+  return pos;
+}
+
+} // namespace
+
+bool try_parse_simple_decimal(const char *s, size_t len, double *val) noexcept {
+  size_t pos = 0;
+  const bool negative = len > 0 && s[0] == '-';
+  if (len > 0 && (s[0] == '-' || s[0] == '+')) {
+    pos++;
+  }
+
+  uint64_t mantissa = 0;
+  size_t significant_digits = 0;
+  const size_t integer_begin = pos;
+  pos = parse_digits(s, pos, len, &mantissa, &significant_digits);
+  size_t digits_count = pos - integer_begin;
+  size_t fraction_digits = 0;
+  if (pos < len && s[pos] == '.') {
+    const size_t fraction_begin = pos + 1;
+    pos = parse_digits(s, fraction_begin, len, &mantissa, &significant_digits);
+    fraction_digits = pos - fraction_begin;
+    digits_count += fraction_digits;
+  }
+
+  if (pos != len || digits_count == 0 || mantissa >= max_exact_mantissa || fraction_digits >= std::size(exact_powers_of_10)) {
+    return false;
+  }
+  // both the mantissa and the power are exact, so the division rounds correctly, like strtod() does
+  const double result = static_cast<double>(mantissa) / exact_powers_of_10[fraction_digits];
+  *val = negative ? -result : result;
+  return true;
+}
+
+size_t try_format_float_precision14(double f, char *out) noexcept {
+  const double abs_f = std::fabs(f);
+  if (!(abs_f >= 1e-4 && abs_f < 1e14)) {
+    return 0; // zero, nan, inf and the exponential notation
+  }
+
+  char *cur = out;
+  if (f < 0) {
+    *cur++ = '-';
+  }
+
+  if (abs_f == std::floor(abs_f)) {
+    return simd_uint64_to_string(static_cast<uint64_t>(abs_f), cur) - out;
+  }
+
+  // 10^exponent <= abs_f < 10^(exponent + 1), with a possible error for negative exponents, it's fixed below
+  int exponent = float_precision - 1;
+  while (exponent >= 0 && abs_f < exact_powers_of_10[exponent]) {
+    --exponent;
+  }
+  if (exponent < 0) {
+    exponent = abs_f >= 1e-1 ? -1 : (abs_f >= 1e-2 ? -2 : (abs_f >= 1e-3 ? -3 : -4));
+  }
+
+  uint64_t mantissa = 0;
+  int scale = 0;
+  for (int attempt = 0; attempt < 2; ++attempt) {
+    scale = float_precision - 1 - exponent;
+    mantissa = static_cast<uint64_t>(std::nearbyint(abs_f * exact_powers_of_10[scale]));
+    if (mantissa >= max_precision_mantissa) {
+      ++exponent;
+    } else if (mantissa < min_precision_mantissa) {
+      --exponent;
+    } else {
+      break;
+    }
+    if (exponent < -4 || exponent >= float_precision) {
+      return 0;
+    }
+  }
+  if (mantissa < min_precision_mantissa || mantissa >= max_precision_mantissa) {
+    return 0;
+  }
+  // if the 14-digit decimal mantissa * 10^-scale is rounded to abs_f, it's closer to abs_f than half of the double precision,
+  // so it's also the correctly rounded 14-digit representation of abs_f, that is exactly what snprintf() prints
+  if (static_cast<double>(mantissa) / exact_powers_of_10[scale] != abs_f) {
+    return 0;
+  }
+
+  char digits[20];
+  simd_uint64_to_string(mantissa, digits);
+  int digits_len = float_precision;
+  while (digits[digits_len - 1] == '0') {
+    --digits_len;
+  }
+
+  if (exponent >= 0) {
+    memcpy(cur, digits, exponent + 1);
+    cur += exponent + 1;
+    if (digits_len > exponent + 1) {
+      *cur++ = '.';
+      memcpy(cur, digits + exponent + 1, digits_len - exponent - 1);
+      cur += digits_len - exponent - 1;
+    }
+  } else {
+    *cur++ = '0';
+    *cur++ = '.';
+    for (int i = exponent; i < -1; ++i) {
+      *cur++ = '0';
+    }
+    memcpy(cur, digits, digits_len);
+    cur += digits_len;
+  }
+  return cur - out;
+}
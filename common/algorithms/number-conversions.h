@@ -0,0 +1,59 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// fast paths of the conversions between numbers and strings:
+// they handle the common cases with exactly the same results as the generic libc-based code (strtod, snprintf),
+// and report everything else to be handled by it
+
+// SWAR: 8 chars are checked and parsed as one little-endian 64-bit word
+inline uint64_t load_8_chars(const char *s) noexcept {
+  uint64_t chunk = 0;
+  memcpy(&chunk, s, sizeof(chunk));
+  return chunk;
+}
+
+inline bool are_8_digits(uint64_t chunk) noexcept {
+  // every byte must be 0x3? both before and after adding 6, that is '0'..'9'
+  return ((chunk & 0xF0F0F0F0F0F0F0F0ULL) | (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) == 0x3333333333333333ULL;
+}
+
+inline uint32_t parse_8_digits(uint64_t chunk) noexcept {
+  // pairs of digits, then quads of digits, then the whole number; the first char is the most significant digit
+  chunk -= 0x3030303030303030ULL;
+  chunk = chunk * 10 + (chunk >> 8);
+  chunk = (((chunk & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) + (((chunk >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))) >> 32;
+  return static_cast<uint32_t>(chunk);
+}
+
+// whether s consists of ASCII digits only (true for an empty s)
+inline bool are_all_digits(const char *s, size_t len) noexcept {
+  size_t i = 0;
+  for (; i + 8 <= len; i += 8) {
+    if (!are_8_digits(load_8_chars(s + i))) {
+      return false;
+    }
+  }
+  for (; i < len; ++i) {
+    if (s[i] < '0' || s[i] > '9') {
+      return false;
+    }
+  }
+  return true;
+}
+
+// parses the whole s of the form [+-]digits[.digits] (like "12", "-0.5", ".25", "3.") when the result is exact without rounding issues:
+// the digits make an integer below 2^53, and there are at most 22 digits after the point;
+// then the result is the same as strtod() gives; returns false for everything else (exponents, whitespace, too many digits, etc.)
+bool try_parse_simple_decimal(const char *s, size_t len, double *val) noexcept;
+
+// formats f like snprintf("%.14G") does, if it's printed in the fixed notation (1e-4 <= |f| < 1e14)
+// and the result is known to be exact (f is the nearest double to its 14-digit decimal representation);
+// returns the length of the written string (at most 20 chars, not zero-terminated) or 0 if snprintf() should be used
+size_t try_format_float_precision14(double f, char *out) noexcept;
@@ -0,0 +1,12 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#pragma once
+
+// simd-url.cpp and simd-utf8.cpp process the bulk of the input by blocks with x86_64 kernels,
+// chosen once by kdb_cpuid(), and finish it with the scalar code, which alone gives the same result.
+//
+// There are no NEON kernels: like for simd-int-to-string.cpp, ARM (Apple M1) is just a target for development,
+// so on ARM the block kernels process nothing and the scalar code does all the work.
+// To add NEON kernels, implement the same block kernel signatures under __aarch64__ and return them from get_kernels().
@@ -0,0 +1,126 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#include "common/algorithms/simd-numeric.h"
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace {
+template<class T, class Cmp>
+T first_extremum_scalar(const std::vector<T> &a, Cmp cmp) {
+  T res = a[0];
+  for (size_t i = 1; i < a.size(); ++i) {
+    if (cmp(a[i], res)) {
+      res = a[i];
+    }
+  }
+  return res;
+}
+
+bool same_double(double lhs, double rhs) {
+  return (std::isnan(lhs) && std::isnan(rhs)) || (lhs == rhs && std::signbit(lhs) == std::signbit(rhs));
+}
+
+// small integers and their halves with zeros of both signs and some NaNs, so that ties and NaN positions matter
+double gen_double(std::mt19937 &gen) {
+  const uint32_t kind = gen() % 100;
+  if (kind < 5) {
+    return std::numeric_limits<double>::quiet_NaN();
+  }
+  if (kind < 15) {
+    return kind % 2 ? 0.0 : -0.0;
+  }
+  return static_cast<int>(gen() % 41 - 20) / 2.0;
+}
+} // namespace
+
+TEST(simd_numeric, int64_sum_and_dot_product) {
+  std::mt19937_64 gen{1};
+  for (size_t n = 0; n < 100; ++n) {
+    std::vector<int64_t> a(n), b(n);
+    uint64_t sum = 0, dot = 0;
+    for (size_t i = 0; i < n; ++i) {
+      a[i] = static_cast<int64_t>(gen());
+      b[i] = static_cast<int64_t>(gen() % 1000) - 500;
+      sum += static_cast<uint64_t>(a[i]);
+      dot += static_cast<uint64_t>(a[i]) * static_cast<uint64_t>(b[i]);
+    }
+    ASSERT_EQ(simd_sum(a.data(), n), static_cast<int64_t>(sum));
+    ASSERT_EQ(simd_dot_product(a.data(), b.data(), n), static_cast<int64_t>(dot));
+  }
+}
+
+TEST(simd_numeric, double_sum_keeps_order) {
+  const double a[] = {1e16, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, -1e16};
+  ASSERT_EQ(simd_sum(a, 10), 0.0);
+  ASSERT_EQ(simd_sum(a, 0), 0.0);
+}
+
+TEST(simd_numeric, int64_min_max) {
+  std::mt19937_64 gen{2};
+  for (int iteration = 0; iteration < 10000; ++iteration) {
+    std::vector<int64_t> a(1 + gen() % 70);
+    for (auto &x : a) {
+      x = static_cast<int64_t>(gen());
+    }
+    ASSERT_EQ(simd_min(a.data(), a.size()), first_extremum_scalar(a, [](int64_t x, int64_t res) { return x < res; }));
+    ASSERT_EQ(simd_max(a.data(), a.size()), first_extremum_scalar(a, [](int64_t x, int64_t res) { return res < x; }));
+  }
+}
+
+TEST(simd_numeric, double_min_max) {
+  std::mt19937 gen{3};
+  for (int iteration = 0; iteration < 100000; ++iteration) {
+    std::vector<double> a(1 + gen() % 70);
+    for (auto &x : a) {
+      x = gen_double(gen);
+    }
+    if (gen() % 3 == 0) {
+      for (auto &x : a) {
+        x = std::fabs(x) * 0.0 * (gen() % 2 ? 1 : -1);
+      }
+    }
+    const double expected_min = first_extremum_scalar(a, [](double x, double res) { return x < res; });
+    const double expected_max = first_extremum_scalar(a, [](double x, double res) { return res < x; });
+    ASSERT_PRED2(same_double, simd_min(a.data(), a.size()), expected_min);
+    ASSERT_PRED2(same_double, simd_max(a.data(), a.size()), expected_max);
+  }
+}
+
+TEST(simd_numeric, element_wise) {
+  std::mt19937 gen{4};
+  for (size_t n = 0; n < 40; ++n) {
+    std::vector<double> a(n), b(n), out(n);
+    for (size_t i = 0; i < n; ++i) {
+      a[i] = gen_double(gen);
+      b[i] = gen_double(gen);
+    }
+    simd_add(a.data(), b.data(), out.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+      ASSERT_PRED2(same_double, out[i], a[i] + b[i]);
+    }
+    simd_sub(a.data(), b.data(), out.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+      ASSERT_PRED2(same_double, out[i], a[i] - b[i]);
+    }
+    simd_mul(a.data(), b.data(), out.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+      ASSERT_PRED2(same_double, out[i], a[i] * b[i]);
+    }
+    simd_scale(a.data(), -2.5, out.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+      ASSERT_PRED2(same_double, out[i], a[i] * -2.5);
+    }
+    const std::vector<double> a_copy = a;
+    simd_add(a.data(), b.data(), a.data(), n);
+    for (size_t i = 0; i < n; ++i) {
+      ASSERT_PRED2(same_double, a[i], a_copy[i] + b[i]);
+    }
+  }
+}
@@ -0,0 +1,187 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#include "common/algorithms/simd-numeric.h"
+
+#include <cstring>
+
+namespace {
+
+typedef uint64_t v4u64 __attribute__((vector_size(32)));
+typedef int64_t v4i64 __attribute__((vector_size(32)));
+typedef double v4f64 __attribute__((vector_size(32)));
+
+constexpr size_t lanes = 4;
+
+// the storage is aligned by 8 only, memcpy is compiled to the unaligned load / store
+template<class V, class T>
+V load(const T *p) noexcept {
+  V v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+template<class V, class T>
+void store(T *p, V v) noexcept {
+  memcpy(p, &v, sizeof(v));
+}
+
+template<class V, class T>
+V broadcast(T x) noexcept {
+  return V{} + x;
+}
+
+struct less {
+  template<class T>
+  auto operator()(T lhs, T rhs) const noexcept {
+    return lhs < rhs;
+  }
+};
+
+struct greater {
+  template<class T>
+  auto operator()(T lhs, T rhs) const noexcept {
+    return rhs < lhs;
+  }
+};
+
+template<class T, class Cmp>
+T first_extremum_scalar(const T *a, size_t n, Cmp cmp) noexcept {
+  T res = a[0];
+  for (size_t i = 1; i < n; ++i) {
+    if (cmp(a[i], res)) {
+      res = a[i];
+    }
+  }
+  return res;
+}
+
+// every lane keeps the extremum of its elements, starting from a[0]: so a leading NaN stays in all the lanes,
+// and other NaNs are never taken, as the comparisons with them are false
+template<class T, class V, class Cmp>
+T first_extremum(const T *a, size_t n, Cmp cmp) noexcept {
+  if (n < 2 * lanes) {
+    return first_extremum_scalar(a, n, cmp);
+  }
+  V m0 = broadcast<V>(a[0]);
+  V m1 = m0;
+  size_t i = 1;
+  for (; i + 2 * lanes <= n; i += 2 * lanes) {
+    const V x0 = load<V>(a + i);
+    const V x1 = load<V>(a + i + lanes);
+    m0 = cmp(x0, m0) ? x0 : m0;
+    m1 = cmp(x1, m1) ? x1 : m1;
+  }
+  T res = a[0];
+  for (size_t lane = 0; lane < lanes; ++lane) {
+    if (cmp(m0[lane], res)) {
+      res = m0[lane];
+    }
+    if (cmp(m1[lane], res)) {
+      res = m1[lane];
+    }
+  }
+  for (; i < n; ++i) {
+    if (cmp(a[i], res)) {
+      res = a[i];
+    }
+  }
+  return res;
+}
+
+template<class Cmp>
+double first_extremum_double(const double *a, size_t n, Cmp cmp) noexcept {
+  const double res = first_extremum<double, v4f64>(a, n, cmp);
+  // 0.0 and -0.0 are equal, but which one goes first depends on the order, that lanes don't keep
+  return res == 0 ? first_extremum_scalar(a, n, cmp) : res;
+}
+
+template<class Op>
+void element_wise(const double *a, const double *b, double *out, size_t n, Op op) noexcept {
+  size_t i = 0;
+  for (; i + lanes <= n; i += lanes) {
+    store(out + i, op(load<v4f64>(a + i), load<v4f64>(b + i)));
+  }
+  for (; i < n; ++i) {
+    out[i] = op(a[i], b[i]);
+  }
+}
+
+} // namespace
+
+int64_t simd_sum(const int64_t *a, size_t n) noexcept {
+  v4u64 s0{};
+  v4u64 s1{};
+  size_t i = 0;
+  for (; i + 2 * lanes <= n; i += 2 * lanes) {
+    s0 += load<v4u64>(a + i);
+    s1 += load<v4u64>(a + i + lanes);
+  }
+  s0 += s1;
+  uint64_t res = s0[0] + s0[1] + s0[2] + s0[3];
+  for (; i < n; ++i) {
+    res += static_cast<uint64_t>(a[i]);
+  }
+  return static_cast<int64_t>(res);
+}
+
+double simd_sum(const double *a, size_t n) noexcept {
+  double res = 0;
+  for (size_t i = 0; i < n; ++i) {
+    res += a[i];
+  }
+  return res;
+}
+
+int64_t simd_min(const int64_t *a, size_t n) noexcept {
+  return first_extremum<int64_t, v4i64>(a, n, less{});
+}
+
+int64_t simd_max(const int64_t *a, size_t n) noexcept {
+  return first_extremum<int64_t, v4i64>(a, n, greater{});
+}
+
+double simd_min(const double *a, size_t n) noexcept {
+  return first_extremum_double(a, n, less{});
+}
+
+double simd_max(const double *a, size_t n) noexcept {
+  return first_extremum_double(a, n, greater{});
+}
+
+int64_t simd_dot_product(const int64_t *a, const int64_t *b, size_t n) noexcept {
+  v4u64 s{};
+  size_t i = 0;
+  for (; i + lanes <= n; i += lanes) {
+    s += load<v4u64>(a + i) * load<v4u64>(b + i);
+  }
+  uint64_t res = s[0] + s[1] + s[2] + s[3];
+  for (; i < n; ++i) {
+    res += static_cast<uint64_t>(a[i]) * static_cast<uint64_t>(b[i]);
+  }
+  return static_cast<int64_t>(res);
+}
+
+void simd_add(const double *a, const double *b, double *out, size_t n) noexcept {
+  element_wise(a, b, out, n, [](auto x, auto y) { return x + y; });
+}
+
+void simd_sub(const double *a, const double *b, double *out, size_t n) noexcept {
+  element_wise(a, b, out, n, [](auto x, auto y) { return x - y; });
+}
+
+void simd_mul(const double *a, const double *b, double *out, size_t n) noexcept {
+  element_wise(a, b, out, n, [](auto x, auto y) { return x * y; });
+}
+
+void simd_scale(const double *a, double k, double *out, size_t n) noexcept {
+  const v4f64 kv = broadcast<v4f64>(k);
+  size_t i = 0;
+  for (; i + lanes <= n; i += lanes) {
+    store(out + i, load<v4f64>(a + i) * kv);
+  }
+  for (; i < n; ++i) {
+    out[i] = a[i] * k;
+  }
+}
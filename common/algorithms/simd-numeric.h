@@ -0,0 +1,33 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// kernels over contiguous int64_t / double storage (vector arrays);
+// they use the generic vector extensions, so they're compiled to the baseline SIMD of the target (AVX on x86_64, NEON on arm),
+// and give exactly the same results as the plain sequential loops
+
+// the sum of a[0..n) with the two's complement wraparound
+int64_t simd_sum(const int64_t *a, size_t n) noexcept;
+// the sum of a[0..n) in the left to right order: floating point addition isn't associative, so it's not reordered
+double simd_sum(const double *a, size_t n) noexcept;
+
+// the first minimal / maximal element like the loop with 'if (a[i] < res) res = a[i]' does, n must be positive;
+// for doubles it means: NaN is returned if a[0] is NaN and other NaNs are skipped, for 0.0 and -0.0 the first one is returned
+int64_t simd_min(const int64_t *a, size_t n) noexcept;
+int64_t simd_max(const int64_t *a, size_t n) noexcept;
+double simd_min(const double *a, size_t n) noexcept;
+double simd_max(const double *a, size_t n) noexcept;
+
+// the sum of a[i] * b[i] with the two's complement wraparound
+int64_t simd_dot_product(const int64_t *a, const int64_t *b, size_t n) noexcept;
+
+// element-wise out[i] = a[i] op b[i] (or a[i] * k), out may be the same as a or b
+void simd_add(const double *a, const double *b, double *out, size_t n) noexcept;
+void simd_sub(const double *a, const double *b, double *out, size_t n) noexcept;
+void simd_mul(const double *a, const double *b, double *out, size_t n) noexcept;
+void simd_scale(const double *a, double k, double *out, size_t n) noexcept;
@@ -0,0 +1,108 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#include "common/algorithms/simd-url.h"
+
+#include <random>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace {
+const std::string alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+std::string base64_encode_reference(const std::string &s) {
+  std::string res;
+  for (size_t i = 0; i + 3 <= s.size(); i += 3) {
+    const uint32_t v = (static_cast<unsigned char>(s[i]) << 16) | (static_cast<unsigned char>(s[i + 1]) << 8) | static_cast<unsigned char>(s[i + 2]);
+    for (int shift = 18; shift >= 0; shift -= 6) {
+      res += alphabet[(v >> shift) & 63];
+    }
+  }
+  return res;
+}
+
+bool is_unreserved(char c) {
+  return isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '.' || c == '_';
+}
+
+std::string gen_bytes(std::mt19937 &gen, size_t len) {
+  std::string res(len, '\0');
+  for (auto &c : res) {
+    c = static_cast<char>(gen());
+  }
+  return res;
+}
+
+std::string gen_base64(std::mt19937 &gen, size_t len) {
+  std::string res(len, '\0');
+  for (auto &c : res) {
+    c = alphabet[gen() % 64];
+  }
+  return res;
+}
+} // namespace
+
+TEST(simd_url, base64_encode_blocks) {
+  std::mt19937 gen{42};
+  for (int iteration = 0; iteration < 10000; ++iteration) {
+    const std::string input = gen_bytes(gen, gen() % 200);
+    std::string out(input.size() / 3 * 4, '\0');
+    const size_t consumed = simd_base64_encode_blocks(reinterpret_cast<const unsigned char *>(input.data()), input.size(), &out[0]);
+    ASSERT_EQ(consumed % 3, 0);
+    ASSERT_LE(consumed, input.size());
+    out.resize(consumed / 3 * 4);
+    ASSERT_EQ(out, base64_encode_reference(input.substr(0, consumed)));
+  }
+}
+
+TEST(simd_url, base64_decode_blocks) {
+  std::mt19937 gen{42};
+  for (int iteration = 0; iteration < 10000; ++iteration) {
+    const std::string bytes = gen_bytes(gen, gen() % 150 / 3 * 3);
+    std::string encoded = base64_encode_reference(bytes);
+    size_t bad_pos = encoded.size();
+    if (!encoded.empty() && gen() % 2) {
+      bad_pos = gen() % encoded.size();
+      const char bad_chars[] = {'=', ' ', '\n', '-', '_', '\0', '\x80', '\xff', '.', ':', '@', '[', '`', '{'};
+      encoded[bad_pos] = bad_chars[gen() % sizeof(bad_chars)];
+    }
+
+    std::string out(bytes.size() + 32, '\0');
+    const size_t consumed = simd_base64_decode_blocks(encoded.data(), encoded.size(), reinterpret_cast<unsigned char *>(&out[0]), out.size());
+    ASSERT_EQ(consumed % 4, 0);
+    ASSERT_LE(consumed, bad_pos / 4 * 4) << encoded;
+    ASSERT_EQ(out.substr(0, consumed / 4 * 3), bytes.substr(0, consumed / 4 * 3)) << encoded;
+  }
+}
+
+TEST(simd_url, base64_decode_respects_capacity) {
+  const std::string encoded = base64_encode_reference(std::string(300, 'x'));
+  std::string out(100, '\0');
+  const size_t consumed = simd_base64_decode_blocks(encoded.data(), encoded.size(), reinterpret_cast<unsigned char *>(&out[0]), out.size());
+  ASSERT_LE(consumed / 4 * 3, out.size());
+  ASSERT_EQ(out.substr(0, consumed / 4 * 3), std::string(consumed / 4 * 3, 'x'));
+}
+
+TEST(simd_url, unreserved_prefix_length) {
+  ASSERT_EQ(url_unreserved_prefix_length("", 0), 0);
+  ASSERT_EQ(url_unreserved_prefix_length("abc def", 7), 3);
+  ASSERT_EQ(url_unreserved_prefix_length("a-b.c_d~", 8), 7);
+  const std::string long_text = std::string(70, 'z') + "/" + std::string(10, '0');
+  ASSERT_EQ(url_unreserved_prefix_length(long_text.c_str(), long_text.size()), 70);
+  ASSERT_EQ(url_unreserved_prefix_length(long_text.c_str() + 71, 10), 10);
+
+  std::mt19937 gen{42};
+  for (int iteration = 0; iteration < 10000; ++iteration) {
+    std::string text = gen_base64(gen, gen() % 200);
+    if (!text.empty() && gen() % 2) {
+      text[gen() % text.size()] = static_cast<char>(gen());
+    }
+    size_t expected = 0;
+    while (expected < text.size() && is_unreserved(text[expected])) {
+      expected++;
+    }
+    ASSERT_EQ(url_unreserved_prefix_length(text.c_str(), text.size()), expected) << text;
+  }
+}
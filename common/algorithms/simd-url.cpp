@@ -0,0 +1,264 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#include "common/algorithms/simd-url.h"
+
+#include <cstdint>
+
+#include "common/algorithms/simd-blocks.h"
+#include "common/cpuid.h"
+
+namespace {
+
+using encode_blocks_t = size_t (*)(const unsigned char *in, size_t len, char *out) noexcept;
+using decode_blocks_t = size_t (*)(const char *in, size_t len, unsigned char *out, size_t out_capacity) noexcept;
+using prefix_length_t = size_t (*)(const char *s, size_t len) noexcept;
+
+struct Kernels {
+  encode_blocks_t base64_encode_blocks;
+  decode_blocks_t base64_decode_blocks;
+  prefix_length_t url_unreserved_blocks;
+};
+
+size_t no_blocks_encode(const unsigned char *, size_t, char *) noexcept {
+  return 0;
+}
+
+size_t no_blocks_decode(const char *, size_t, unsigned char *, size_t) noexcept {
+  return 0;
+}
+
+inline bool is_url_unreserved(char c) noexcept {
+  return ('0' <= c && c <= '9') || ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z') || c == '-' || c == '.' || c == '_';
+}
+
+} // namespace
+
+#ifdef __x86_64__
+
+#include <immintrin.h>
+
+// the base64 kernels are based on the algorithms by Wojciech Muła and Daniel Lemire,
+// see "Faster Base64 Encoding and Decoding using AVX2 Instructions" and https://github.com/aklomp/base64
+
+namespace {
+
+#define BASE64_SHIFT_LUT 'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, \
+                         '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0
+
+// 6-bit values in bytes -> base64 alphabet chars
+__attribute__((target("ssse3")))
+inline __m128i base64_encode_lookup(__m128i indices) noexcept {
+  __m128i reduced = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+  reduced = _mm_or_si128(reduced, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+  return _mm_add_epi8(_mm_shuffle_epi8(_mm_setr_epi8(BASE64_SHIFT_LUT), reduced), indices);
+}
+
+__attribute__((target("avx2")))
+inline __m256i base64_encode_lookup(__m256i indices) noexcept {
+  __m256i reduced = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+  reduced = _mm256_or_si256(reduced, _mm256_and_si256(_mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices), _mm256_set1_epi8(13)));
+  return _mm256_add_epi8(_mm256_shuffle_epi8(_mm256_setr_epi8(BASE64_SHIFT_LUT, BASE64_SHIFT_LUT), reduced), indices);
+}
+
+#undef BASE64_SHIFT_LUT
+
+__attribute__((target("ssse3")))
+size_t base64_encode_blocks_ssse3(const unsigned char *in, size_t len, char *out) noexcept {
+  size_t pos = 0;
+  // 12 bytes are encoded, but 16 are loaded
+  for (; pos + 16 <= len; pos += 12, out += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + pos));
+    v = _mm_shuffle_epi8(v, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    const __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(v, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+    const __m128i t1 = _mm_mullo_epi16(_mm_and_si128(v, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+    const __m128i indices = _mm_or_si128(t0, t1);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), base64_encode_lookup(indices));
+  }
+  return pos;
+}
+
+__attribute__((target("avx2")))
+size_t base64_encode_blocks_avx2(const unsigned char *in, size_t len, char *out) noexcept {
+  size_t pos = 0;
+  // 2 x 12 bytes are encoded, one for every 128-bit lane
+  for (; pos + 28 <= len; pos += 24, out += 32) {
+    const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + pos));
+    const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + pos + 12));
+    __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+    v = _mm256_shuffle_epi8(v, _mm256_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+                                               10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    const __m256i t0 = _mm256_mulhi_epu16(_mm256_and_si256(v, _mm256_set1_epi32(0x0fc0fc00)), _mm256_set1_epi32(0x04000040));
+    const __m256i t1 = _mm256_mullo_epi16(_mm256_and_si256(v, _mm256_set1_epi32(0x003f03f0)), _mm256_set1_epi32(0x01000010));
+    const __m256i indices = _mm256_or_si256(t0, t1);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out), base64_encode_lookup(indices));
+  }
+  return pos + base64_encode_blocks_ssse3(in + pos, len - pos, out);
+}
+
+// base64 alphabet chars -> 6-bit values; lo & hi is non-zero for any char outside the alphabet ('=' and whitespace included)
+#define BASE64_DECODE_LUT_LO 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A
+#define BASE64_DECODE_LUT_HI 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10
+#define BASE64_DECODE_LUT_ROLL 0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0
+#define BASE64_DECODE_PACK_SHUFFLE 2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1
+
+__attribute__((target("ssse3")))
+size_t base64_decode_blocks_ssse3(const char *in, size_t len, unsigned char *out, size_t out_capacity) noexcept {
+  const __m128i mask_2f = _mm_set1_epi8(0x2f);
+  const __m128i lut_lo = _mm_setr_epi8(BASE64_DECODE_LUT_LO);
+  const __m128i lut_hi = _mm_setr_epi8(BASE64_DECODE_LUT_HI);
+  const __m128i lut_roll = _mm_setr_epi8(BASE64_DECODE_LUT_ROLL);
+  size_t pos = 0;
+  size_t out_pos = 0;
+  // 16 chars are decoded into 12 bytes, but 16 are stored
+  for (; pos + 16 <= len && out_pos + 16 <= out_capacity; pos += 16, out_pos += 12) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + pos));
+    const __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(v, 4), mask_2f);
+    const __m128i lo = _mm_shuffle_epi8(lut_lo, _mm_and_si128(v, mask_2f));
+    const __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0xffff) {
+      break;
+    }
+    const __m128i roll = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(_mm_cmpeq_epi8(v, mask_2f), hi_nibbles));
+    v = _mm_add_epi8(v, roll);
+    v = _mm_madd_epi16(_mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000));
+    v = _mm_shuffle_epi8(v, _mm_setr_epi8(BASE64_DECODE_PACK_SHUFFLE));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + out_pos), v);
+  }
+  return pos;
+}
+
+__attribute__((target("avx2")))
+size_t base64_decode_blocks_avx2(const char *in, size_t len, unsigned char *out, size_t out_capacity) noexcept {
+  const __m256i mask_2f = _mm256_set1_epi8(0x2f);
+  const __m256i lut_lo = _mm256_setr_epi8(BASE64_DECODE_LUT_LO, BASE64_DECODE_LUT_LO);
+  const __m256i lut_hi = _mm256_setr_epi8(BASE64_DECODE_LUT_HI, BASE64_DECODE_LUT_HI);
+  const __m256i lut_roll = _mm256_setr_epi8(BASE64_DECODE_LUT_ROLL, BASE64_DECODE_LUT_ROLL);
+  size_t pos = 0;
+  size_t out_pos = 0;
+  // 32 chars are decoded into 24 bytes, but 32 are stored
+  for (; pos + 32 <= len && out_pos + 32 <= out_capacity; pos += 32, out_pos += 24) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + pos));
+    const __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(v, 4), mask_2f);
+    const __m256i lo = _mm256_shuffle_epi8(lut_lo, _mm256_and_si256(v, mask_2f));
+    const __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+    if (!_mm256_testz_si256(lo, hi)) {
+      break;
+    }
+    const __m256i roll = _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(_mm256_cmpeq_epi8(v, mask_2f), hi_nibbles));
+    v = _mm256_add_epi8(v, roll);
+    v = _mm256_madd_epi16(_mm256_maddubs_epi16(v, _mm256_set1_epi32(0x01400140)), _mm256_set1_epi32(0x00011000));
+    v = _mm256_shuffle_epi8(v, _mm256_setr_epi8(BASE64_DECODE_PACK_SHUFFLE, BASE64_DECODE_PACK_SHUFFLE));
+    // 12 bytes in every lane -> 24 contiguous bytes
+    v = _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + out_pos), v);
+  }
+  return pos + base64_decode_blocks_ssse3(in + pos, len - pos, out + out_pos, out_capacity - out_pos);
+}
+
+#undef BASE64_DECODE_LUT_LO
+#undef BASE64_DECODE_LUT_HI
+#undef BASE64_DECODE_LUT_ROLL
+#undef BASE64_DECODE_PACK_SHUFFLE
+
+// [0-9a-zA-Z._-] by signed comparisons, bytes >= 0x80 are negative and never match
+inline __m128i in_range(__m128i v, char from, char to) noexcept {
+  return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(static_cast<char>(from - 1))), _mm_cmplt_epi8(v, _mm_set1_epi8(static_cast<char>(to + 1))));
+}
+
+inline uint32_t url_unreserved_mask(__m128i v) noexcept {
+  const __m128i alnum = _mm_or_si128(in_range(v, '0', '9'), _mm_or_si128(in_range(v, 'a', 'z'), in_range(v, 'A', 'Z')));
+  const __m128i punct = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('-')),
+                                     _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('.')), _mm_cmpeq_epi8(v, _mm_set1_epi8('_'))));
+  return static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(alnum, punct)));
+}
+
+__attribute__((target("avx2")))
+inline __m256i in_range(__m256i v, char from, char to) noexcept {
+  return _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8(static_cast<char>(from - 1))),
+                          _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(to + 1)), v));
+}
+
+__attribute__((target("avx2")))
+inline uint32_t url_unreserved_mask(__m256i v) noexcept {
+  const __m256i alnum = _mm256_or_si256(in_range(v, '0', '9'), _mm256_or_si256(in_range(v, 'a', 'z'), in_range(v, 'A', 'Z')));
+  const __m256i punct = _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('-')),
+                                        _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('.')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('_'))));
+  return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(alnum, punct)));
+}
+
+size_t url_unreserved_blocks_sse2(const char *s, size_t len) noexcept {
+  size_t pos = 0;
+  for (; pos + 16 <= len; pos += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + pos));
+    const auto reserved = ~url_unreserved_mask(v) & 0xffff;
+    if (reserved) {
+      return pos + __builtin_ctz(reserved);
+    }
+  }
+  return pos;
+}
+
+__attribute__((target("avx2")))
+size_t url_unreserved_blocks_avx2(const char *s, size_t len) noexcept {
+  size_t pos = 0;
+  for (; pos + 32 <= len; pos += 32) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + pos));
+    const auto reserved = ~url_unreserved_mask(v);
+    if (reserved) {
+      return pos + __builtin_ctz(reserved);
+    }
+  }
+  return pos + url_unreserved_blocks_sse2(s + pos, len - pos);
+}
+
+const Kernels &get_kernels() noexcept {
+  static const Kernels kernels = [] {
+    const kdb_cpuid_t *cpuid = kdb_cpuid();
+    if (cpuid->x86_64.ext_ebx & (1 << 5)) {
+      return Kernels{base64_encode_blocks_avx2, base64_decode_blocks_avx2, url_unreserved_blocks_avx2};
+    }
+    if (cpuid->x86_64.ecx & (1 << 9)) {
+      return Kernels{base64_encode_blocks_ssse3, base64_decode_blocks_ssse3, url_unreserved_blocks_sse2};
+    }
+    return Kernels{no_blocks_encode, no_blocks_decode, url_unreserved_blocks_sse2};
+  }();
+  return kernels;
+}
+
+} // namespace
+
+#else
+// no NEON kernels yet, see simd-blocks.h
+
+namespace {
+
+size_t no_blocks_prefix(const char *, size_t) noexcept {
+  return 0;
+}
+
+const Kernels &get_kernels() noexcept {
+  static const Kernels kernels{no_blocks_encode, no_blocks_decode, no_blocks_prefix};
+  return kernels;
+}
+
+} // namespace
+
+#endif
+
+size_t simd_base64_encode_blocks(const unsigned char *in, size_t len, char *out) noexcept {
+  return get_kernels().base64_encode_blocks(in, len, out);
+}
+
+size_t simd_base64_decode_blocks(const char *in, size_t len, unsigned char *out, size_t out_capacity) noexcept {
+  return get_kernels().base64_decode_blocks(in, len, out, out_capacity);
+}
+
+size_t url_unreserved_prefix_length(const char *s, size_t len) noexcept {
+  size_t pos = get_kernels().url_unreserved_blocks(s, len);
+  while (pos < len && is_url_unreserved(s[pos])) {
+    pos++;
+  }
+  return pos;
+}
@@ -0,0 +1,23 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#pragma once
+
+#include <cstddef>
+
+// SIMD kernels for base64 and url encoding: they process whole blocks only,
+// and the caller handles the rest (tails, padding, whitespace, errors) with a scalar code;
+// the implementation (SSSE3 or AVX2) is chosen at runtime with kdb_cpuid()
+
+// encodes whole blocks of the input, writes 4 chars for every 3 bytes to out;
+// returns the number of consumed input bytes, a multiple of 3
+size_t simd_base64_encode_blocks(const unsigned char *in, size_t len, char *out) noexcept;
+
+// decodes whole blocks of the input while they consist of base64 alphabet chars only (no padding, no whitespace),
+// writes 3 bytes for every 4 chars to out, which has out_capacity bytes;
+// returns the number of consumed chars, a multiple of 4
+size_t simd_base64_decode_blocks(const char *in, size_t len, unsigned char *out, size_t out_capacity) noexcept;
+
+// the length of the leading run of chars that are not escaped by urlencode(): [0-9a-zA-Z._-]
+size_t url_unreserved_prefix_length(const char *s, size_t len) noexcept;
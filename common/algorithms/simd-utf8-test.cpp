@@ -0,0 +1,87 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#include "common/algorithms/simd-utf8.h"
+
+#include <random>
+#include <string>
+
+#include <gtest/gtest.h>
+
+namespace {
+size_t ascii_prefix_length_scalar(const std::string &s) {
+  size_t i = 0;
+  while (i < s.size() && static_cast<unsigned char>(s[i]) - 1u < 0x7fu) {
+    i++;
+  }
+  return i;
+}
+
+// mostly ASCII with some cyrillic and emoji, sometimes broken sequences and zero bytes,
+// so that all the block boundaries are crossed in different states
+std::string gen_text(std::mt19937 &gen, size_t len) {
+  static const std::string pieces[] = {"a", "Z", " ", "0123456789", "abcdefghijklmnopqrstuvwxyz", "\xd0\xbf\xd1\x80\xd0\xb8", "\xe2\x82\xac",
+                                       "\xf0\x9f\x98\x80", "\x80", "\xbf", "\xc0", "\xff"};
+  std::string res;
+  while (res.size() < len) {
+    const size_t piece = gen() % 100;
+    if (piece < 60) {
+      res += pieces[gen() % 5];
+    } else if (piece < 95) {
+      res += pieces[5 + gen() % 3];
+    } else if (piece < 99) {
+      res += pieces[8 + gen() % 4];
+    } else {
+      res += '\0';
+    }
+  }
+  res.resize(len);
+  return res;
+}
+} // namespace
+
+TEST(simd_utf8, count_code_points) {
+  ASSERT_EQ(utf8_count_code_points("", 0), 0);
+  ASSERT_EQ(utf8_count_code_points("hello", 5), 5);
+  ASSERT_EQ(utf8_count_code_points("\xd0\xbf\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82", 12), 6);
+  const std::string long_text(100, 'x');
+  ASSERT_EQ(utf8_count_code_points(long_text.c_str(), long_text.size()), 100);
+  ASSERT_EQ(utf8_count_code_points(long_text.c_str(), 37), 37);
+  std::string with_zero = long_text;
+  with_zero[70] = '\0';
+  ASSERT_EQ(utf8_count_code_points(with_zero.c_str(), with_zero.size()), 70);
+}
+
+TEST(simd_utf8, advance) {
+  const std::string text = std::string(40, 'a') + "\xd0\xbf\xd1\x80\xd0\xb8" + std::string(40, 'b');
+  ASSERT_EQ(utf8_advance(text.c_str(), text.size(), 0), 0);
+  ASSERT_EQ(utf8_advance(text.c_str(), text.size(), 40), 40);
+  ASSERT_EQ(utf8_advance(text.c_str(), text.size(), 41), 42);
+  ASSERT_EQ(utf8_advance(text.c_str(), text.size(), 43), 46);
+  ASSERT_EQ(utf8_advance(text.c_str(), text.size(), 1000), text.size());
+}
+
+TEST(simd_utf8, ascii_prefix_length) {
+  const std::string text = std::string(50, 'a') + "\xd0\xbf" + std::string(50, 'b');
+  ASSERT_EQ(utf8_ascii_prefix_length(text.c_str(), text.size()), 50);
+  ASSERT_EQ(utf8_ascii_prefix_length(text.c_str() + 52, 50), 50);
+  ASSERT_EQ(utf8_ascii_prefix_length(text.c_str(), 33), 33);
+  ASSERT_EQ(utf8_ascii_prefix_length("abc\0def", 7), 3);
+}
+
+TEST(simd_utf8, fuzz_against_scalar) {
+  std::mt19937 gen{42};
+  for (int iteration = 0; iteration < 20000; ++iteration) {
+    const std::string text = gen_text(gen, gen() % 200);
+    const char *s = text.c_str();
+    const size_t offset = text.empty() ? 0 : gen() % text.size();
+    const size_t len = text.size() - offset;
+
+    ASSERT_EQ(utf8_count_code_points(s + offset, len), utf8_count_code_points_scalar(s + offset, len)) << text;
+    ASSERT_EQ(utf8_ascii_prefix_length(s + offset, len), ascii_prefix_length_scalar(text.substr(offset))) << text;
+    for (size_t cnt : {size_t{0}, size_t{1}, gen() % 64, gen() % 256, len}) {
+      ASSERT_EQ(utf8_advance(s + offset, len, cnt), utf8_advance_scalar(s + offset, len, cnt)) << text << " " << cnt;
+    }
+  }
+}
@@ -0,0 +1,192 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#include "common/algorithms/simd-utf8.h"
+
+#include <cstdint>
+#include <limits>
+
+#include "common/algorithms/simd-blocks.h"
+#include "common/cpuid.h"
+
+namespace {
+
+inline bool is_code_point_start(char c) noexcept {
+  return (static_cast<unsigned char>(c) & 0xc0) != 0x80;
+}
+
+// a block kernel scans whole blocks from the beginning of s
+// and stops before a block with '\0', or before a block that would make the number of code points greater than max_code_points;
+// it returns the number of scanned bytes and stores the number of code points in them
+using scan_blocks_t = size_t (*)(const char *s, size_t len, size_t max_code_points, size_t *code_points) noexcept;
+// the length of the leading run of non-zero ASCII bytes, within whole blocks only
+using ascii_blocks_t = size_t (*)(const char *s, size_t len) noexcept;
+
+} // namespace
+
+#ifdef __x86_64__
+
+#include <immintrin.h>
+
+namespace {
+
+// the base x86_64 target has SSE2, so it's the fallback; AVX2 is chosen at runtime if the CPU supports it
+// (continuation bytes 10xxxxxx are exactly the signed bytes less than -64)
+
+size_t scan_blocks_sse2(const char *s, size_t len, size_t max_code_points, size_t *code_points) noexcept {
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i continuation_bound = _mm_set1_epi8(-64);
+  size_t pos = 0;
+  size_t count = 0;
+  for (; pos + 16 <= len; pos += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + pos));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(v, zero))) {
+      break;
+    }
+    const auto continuations = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmplt_epi8(v, continuation_bound)));
+    const size_t block_code_points = 16 - __builtin_popcount(continuations);
+    if (count + block_code_points > max_code_points) {
+      break;
+    }
+    count += block_code_points;
+  }
+  *code_points = count;
+  return pos;
+}
+
+size_t ascii_blocks_sse2(const char *s, size_t len) noexcept {
+  const __m128i zero = _mm_setzero_si128();
+  size_t pos = 0;
+  for (; pos + 16 <= len; pos += 16) {
+    const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(s + pos));
+    const auto stop_bytes = static_cast<uint32_t>(_mm_movemask_epi8(_mm_or_si128(v, _mm_cmpeq_epi8(v, zero))));
+    if (stop_bytes) {
+      return pos + __builtin_ctz(stop_bytes);
+    }
+  }
+  return pos;
+}
+
+__attribute__((target("avx2")))
+size_t scan_blocks_avx2(const char *s, size_t len, size_t max_code_points, size_t *code_points) noexcept {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i continuation_bound = _mm256_set1_epi8(-64);
+  size_t pos = 0;
+  size_t count = 0;
+  for (; pos + 32 <= len; pos += 32) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + pos));
+    if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, zero))) {
+      break;
+    }
+    const auto continuations = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpgt_epi8(continuation_bound, v)));
+    const size_t block_code_points = 32 - __builtin_popcount(continuations);
+    if (count + block_code_points > max_code_points) {
+      break;
+    }
+    count += block_code_points;
+  }
+  *code_points = count;
+  return pos;
+}
+
+__attribute__((target("avx2")))
+size_t ascii_blocks_avx2(const char *s, size_t len) noexcept {
+  const __m256i zero = _mm256_setzero_si256();
+  size_t pos = 0;
+  for (; pos + 32 <= len; pos += 32) {
+    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(s + pos));
+    const auto stop_bytes = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(v, _mm256_cmpeq_epi8(v, zero))));
+    if (stop_bytes) {
+      return pos + __builtin_ctz(stop_bytes);
+    }
+  }
+  return pos;
+}
+
+struct Kernels {
+  scan_blocks_t scan_blocks;
+  ascii_blocks_t ascii_blocks;
+};
+
+const Kernels &get_kernels() noexcept {
+  static const Kernels kernels = [] {
+    // unlike __builtin_cpu_supports, kdb_cpuid() also checks that the OS saves the ymm state
+    if (kdb_cpuid()->x86_64.ext_ebx & (1 << 5)) {
+      return Kernels{scan_blocks_avx2, ascii_blocks_avx2};
+    }
+    return Kernels{scan_blocks_sse2, ascii_blocks_sse2};
+  }();
+  return kernels;
+}
+
+} // namespace
+
+#else
+// no NEON kernels yet, see simd-blocks.h
+
+namespace {
+
+size_t scan_blocks_scalar(const char *, size_t, size_t, size_t *code_points) noexcept {
+  *code_points = 0;
+  return 0;
+}
+
+size_t ascii_blocks_scalar(const char *, size_t) noexcept {
+  return 0;
+}
+
+struct Kernels {
+  scan_blocks_t scan_blocks;
+  ascii_blocks_t ascii_blocks;
+};
+
+const Kernels &get_kernels() noexcept {
+  static const Kernels kernels{scan_blocks_scalar, ascii_blocks_scalar};
+  return kernels;
+}
+
+} // namespace
+
+#endif
+
+size_t utf8_count_code_points_scalar(const char *s, size_t len) noexcept {
+  size_t res = 0;
+  for (size_t i = 0; i < len && s[i]; i++) {
+    res += is_code_point_start(s[i]);
+  }
+  return res;
+}
+
+size_t utf8_advance_scalar(const char *s, size_t len, size_t cnt) noexcept {
+  size_t i = 0;
+  for (; i < len && s[i]; i++) {
+    if (is_code_point_start(s[i])) {
+      if (cnt == 0) {
+        return i;
+      }
+      cnt--;
+    }
+  }
+  return i;
+}
+
+size_t utf8_ascii_prefix_length(const char *s, size_t len) noexcept {
+  size_t pos = get_kernels().ascii_blocks(s, len);
+  while (pos < len && static_cast<unsigned char>(s[pos]) - 1u < 0x7fu) {
+    pos++;
+  }
+  return pos;
+}
+
+size_t utf8_count_code_points(const char *s, size_t len) noexcept {
+  size_t code_points = 0;
+  const size_t pos = get_kernels().scan_blocks(s, len, std::numeric_limits<size_t>::max(), &code_points);
+  return code_points + utf8_count_code_points_scalar(s + pos, len - pos);
+}
+
+size_t utf8_advance(const char *s, size_t len, size_t cnt) noexcept {
+  size_t code_points = 0;
+  const size_t pos = get_kernels().scan_blocks(s, len, cnt, &code_points);
+  return pos + utf8_advance_scalar(s + pos, len - pos, cnt - code_points);
+}
@@ -0,0 +1,24 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#pragma once
+
+#include <cstddef>
+
+// all functions treat s as a zero-terminated string of at most len bytes:
+// they stop at the first '\0', like the scalar mbstring loops do;
+// whole blocks of 16 (or 32 with AVX2) bytes are processed at once, the rest is processed byte by byte
+
+// the length of the leading run of non-zero ASCII bytes
+size_t utf8_ascii_prefix_length(const char *s, size_t len) noexcept;
+
+// the number of code points, that is the number of bytes that are not continuation bytes (10xxxxxx)
+size_t utf8_count_code_points(const char *s, size_t len) noexcept;
+
+// the offset of the code point with index cnt, or the length of the string if there are fewer code points
+size_t utf8_advance(const char *s, size_t len, size_t cnt) noexcept;
+
+// scalar versions of the functions above, the reference for the tests
+size_t utf8_count_code_points_scalar(const char *s, size_t len) noexcept;
+size_t utf8_advance_scalar(const char *s, size_t len, size_t cnt) noexcept;
@@ -0,0 +1,32 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#include "common/algorithms/xxh3.h"
+
+#include <string>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+TEST(xxh3, known_hashes) {
+  ASSERT_EQ(xxh3_64("", 0), 0x2d06800538d394c2ULL);
+  ASSERT_EQ(xxh3_64("abc", 3), 0x78af5f94892f3950ULL);
+}
+
+TEST(xxh3, all_length_classes) {
+  std::string data(5000, '\0');
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<char>((i * 31 + 7) % 251);
+  }
+  // the reference values are computed with the original xxHash library
+  const std::pair<size_t, uint64_t> expected[] = {
+    {0, 0x2d06800538d394c2ULL},    {1, 0x4c5cca45d0f4811fULL},    {3, 0x15f7093b173d005cULL},    {4, 0xdca012f95811b6b9ULL},
+    {8, 0xdec6a9a43575982eULL},    {9, 0x15e553b97e27735dULL},    {16, 0xa7683b861e585aa6ULL},   {17, 0x637c1aa907698945ULL},
+    {128, 0x6d0f64c82ddaad27ULL},  {129, 0xeaf3fc97c05f44f3ULL},  {240, 0x22f28cbbfaf0447fULL},  {241, 0x07525dbc14902c7fULL},
+    {1024, 0xe2898655db7bc9eeULL}, {1025, 0x134c652ba3d6fb9eULL}, {2049, 0x0bfdaada21607d33ULL},
+  };
+  for (const auto &[len, hash] : expected) {
+    ASSERT_EQ(xxh3_64(data.data(), len), hash) << len;
+  }
+}
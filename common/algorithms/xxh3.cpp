@@ -0,0 +1,212 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#include "common/algorithms/xxh3.h"
+
+#include <cstring>
+
+namespace {
+
+constexpr uint64_t PRIME32_1 = 0x9E3779B1U;
+constexpr uint64_t PRIME32_2 = 0x85EBCA77U;
+constexpr uint64_t PRIME32_3 = 0xC2B2AE3DU;
+constexpr uint64_t PRIME64_1 = 0x9E3779B185EBCA87ULL;
+constexpr uint64_t PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr uint64_t PRIME64_3 = 0x165667B19E3779F9ULL;
+constexpr uint64_t PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+constexpr uint64_t PRIME64_5 = 0x27D4EB2F165667C5ULL;
+constexpr uint64_t PRIME_MX1 = 0x165667919E3779F9ULL;
+constexpr uint64_t PRIME_MX2 = 0x9FB21C651E98DF25ULL;
+
+constexpr size_t SECRET_SIZE = 192;
+constexpr size_t STRIPE_LEN = 64;
+constexpr size_t SECRET_CONSUME_RATE = 8;
+constexpr size_t ACC_NB = STRIPE_LEN / sizeof(uint64_t);
+
+alignas(64) constexpr uint8_t default_secret[SECRET_SIZE] = {
+  0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+  0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+  0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+  0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+  0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+  0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+  0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+  0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+  0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+  0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+  0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+  0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+// the reads are little-endian, as all the supported platforms are
+inline uint32_t read32(const uint8_t *p) noexcept {
+  uint32_t res = 0;
+  memcpy(&res, p, sizeof(res));
+  return res;
+}
+
+inline uint64_t read64(const uint8_t *p) noexcept {
+  uint64_t res = 0;
+  memcpy(&res, p, sizeof(res));
+  return res;
+}
+
+inline uint64_t rotl64(uint64_t x, int r) noexcept {
+  return (x << r) | (x >> (64 - r));
+}
+
+inline uint64_t mul128_fold64(uint64_t lhs, uint64_t rhs) noexcept {
+  const unsigned __int128 product = static_cast<unsigned __int128>(lhs) * rhs;
+  return static_cast<uint64_t>(product) ^ static_cast<uint64_t>(product >> 64);
+}
+
+inline uint64_t xxh64_avalanche(uint64_t h) noexcept {
+  h ^= h >> 33;
+  h *= PRIME64_2;
+  h ^= h >> 29;
+  h *= PRIME64_3;
+  h ^= h >> 32;
+  return h;
+}
+
+inline uint64_t avalanche(uint64_t h) noexcept {
+  h ^= h >> 37;
+  h *= PRIME_MX1;
+  h ^= h >> 32;
+  return h;
+}
+
+inline uint64_t rrmxmx(uint64_t h, uint64_t len) noexcept {
+  h ^= rotl64(h, 49) ^ rotl64(h, 24);
+  h *= PRIME_MX2;
+  h ^= (h >> 35) + len;
+  h *= PRIME_MX2;
+  return h ^ (h >> 28);
+}
+
+inline uint64_t mix16(const uint8_t *input, const uint8_t *secret) noexcept {
+  return mul128_fold64(read64(input) ^ read64(secret), read64(input + 8) ^ read64(secret + 8));
+}
+
+uint64_t hash_0_to_16(const uint8_t *input, size_t len) noexcept {
+  const uint8_t *secret = default_secret;
+  if (len > 8) {
+    const uint64_t input_lo = read64(input) ^ (read64(secret + 24) ^ read64(secret + 32));
+    const uint64_t input_hi = read64(input + len - 8) ^ (read64(secret + 40) ^ read64(secret + 48));
+    return avalanche(len + __builtin_bswap64(input_lo) + input_hi + mul128_fold64(input_lo, input_hi));
+  }
+  if (len >= 4) {
+    const uint64_t input64 = read32(input + len - 4) + (static_cast<uint64_t>(read32(input)) << 32);
+    return rrmxmx(input64 ^ (read64(secret + 8) ^ read64(secret + 16)), len);
+  }
+  if (len > 0) {
+    const uint32_t combined = (static_cast<uint32_t>(input[0]) << 16) | (static_cast<uint32_t>(input[len >> 1]) << 24) | input[len - 1] |
+                              (static_cast<uint32_t>(len) << 8);
+    return xxh64_avalanche(combined ^ static_cast<uint64_t>(read32(secret) ^ read32(secret + 4)));
+  }
+  return xxh64_avalanche(read64(secret + 56) ^ read64(secret + 64));
+}
+
+uint64_t hash_17_to_128(const uint8_t *input, size_t len) noexcept {
+  const uint8_t *secret = default_secret;
+  uint64_t acc = len * PRIME64_1;
+  if (len > 32) {
+    if (len > 64) {
+      if (len > 96) {
+        acc += mix16(input + 48, secret + 96);
+        acc += mix16(input + len - 64, secret + 112);
+      }
+      acc += mix16(input + 32, secret + 64);
+      acc += mix16(input + len - 48, secret + 80);
+    }
+    acc += mix16(input + 16, secret + 32);
+    acc += mix16(input + len - 32, secret + 48);
+  }
+  acc += mix16(input, secret);
+  acc += mix16(input + len - 16, secret + 16);
+  return avalanche(acc);
+}
+
+uint64_t hash_129_to_240(const uint8_t *input, size_t len) noexcept {
+  constexpr size_t start_offset = 3;
+  constexpr size_t last_offset = 17;
+  constexpr size_t secret_size_min = 136;
+
+  const uint8_t *secret = default_secret;
+  uint64_t acc = len * PRIME64_1;
+  for (size_t i = 0; i < 8; i++) {
+    acc += mix16(input + 16 * i, secret + 16 * i);
+  }
+  acc = avalanche(acc);
+  uint64_t acc_end = mix16(input + len - 16, secret + secret_size_min - last_offset);
+  for (size_t i = 8; i < len / 16; i++) {
+    acc_end += mix16(input + 16 * i, secret + 16 * (i - 8) + start_offset);
+  }
+  return avalanche(acc + acc_end);
+}
+
+inline void accumulate_stripe(uint64_t *acc, const uint8_t *input, const uint8_t *secret) noexcept {
+  for (size_t i = 0; i < ACC_NB; i++) {
+    const uint64_t data_val = read64(input + 8 * i);
+    const uint64_t data_key = data_val ^ read64(secret + 8 * i);
+    acc[i ^ 1] += data_val;
+    acc[i] += (data_key & 0xFFFFFFFFU) * (data_key >> 32);
+  }
+}
+
+inline void scramble(uint64_t *acc, const uint8_t *secret) noexcept {
+  for (size_t i = 0; i < ACC_NB; i++) {
+    uint64_t a = acc[i];
+    a ^= a >> 47;
+    a ^= read64(secret + 8 * i);
+    a *= PRIME32_1;
+    acc[i] = a;
+  }
+}
+
+uint64_t hash_long(const uint8_t *input, size_t len) noexcept {
+  constexpr size_t stripes_per_block = (SECRET_SIZE - STRIPE_LEN) / SECRET_CONSUME_RATE;
+  constexpr size_t block_len = STRIPE_LEN * stripes_per_block;
+  constexpr size_t last_stripe_secret_offset = SECRET_SIZE - STRIPE_LEN - 7;
+  constexpr size_t merge_secret_offset = 11;
+
+  const uint8_t *secret = default_secret;
+  alignas(64) uint64_t acc[ACC_NB] = {PRIME32_3, PRIME64_1, PRIME64_2, PRIME64_3, PRIME64_4, PRIME32_2, PRIME64_5, PRIME32_1};
+
+  const size_t blocks = (len - 1) / block_len;
+  for (size_t n = 0; n < blocks; n++) {
+    for (size_t s = 0; s < stripes_per_block; s++) {
+      accumulate_stripe(acc, input + n * block_len + s * STRIPE_LEN, secret + s * SECRET_CONSUME_RATE);
+    }
+    scramble(acc, secret + SECRET_SIZE - STRIPE_LEN);
+  }
+  const size_t last_stripes = ((len - 1) - block_len * blocks) / STRIPE_LEN;
+  for (size_t s = 0; s < last_stripes; s++) {
+    accumulate_stripe(acc, input + blocks * block_len + s * STRIPE_LEN, secret + s * SECRET_CONSUME_RATE);
+  }
+  accumulate_stripe(acc, input + len - STRIPE_LEN, secret + last_stripe_secret_offset);
+
+  uint64_t result = len * PRIME64_1;
+  for (size_t i = 0; i < ACC_NB / 2; i++) {
+    result += mul128_fold64(acc[2 * i] ^ read64(secret + merge_secret_offset + 16 * i),
+                            acc[2 * i + 1] ^ read64(secret + merge_secret_offset + 16 * i + 8));
+  }
+  return avalanche(result);
+}
+
+} // namespace
+
+uint64_t xxh3_64(const void *data, size_t len) noexcept {
+  const auto *input = static_cast<const uint8_t *>(data);
+  if (len <= 16) {
+    return hash_0_to_16(input, len);
+  }
+  if (len <= 128) {
+    return hash_17_to_128(input, len);
+  }
+  if (len <= 240) {
+    return hash_129_to_240(input, len);
+  }
+  return hash_long(input, len);
+}
@@ -0,0 +1,12 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// XXH3 64-bit hash with the default secret and zero seed, see https://github.com/Cyan4973/xxHash;
+// the result is the same as XXH3_64bits() gives, and as php hash('xxh3') prints in hex
+uint64_t xxh3_64(const void *data, size_t len) noexcept;
@@ -2,13 +2,19 @@ prepend(COMMON_TESTS_SOURCES ${COMMON_DIR}/
         algorithms/compare-test.cpp
         algorithms/contains-test.cpp
         algorithms/hashes-test.cpp
+        algorithms/number-conversions-test.cpp
         algorithms/projections-test.cpp
         algorithms/simd-int-to-string-test.cpp
+        algorithms/simd-numeric-test.cpp
+        algorithms/simd-utf8-test.cpp
+        algorithms/simd-url-test.cpp
         algorithms/string-algorithms-test.cpp
+        algorithms/xxh3-test.cpp
         allocators/freelist-test.cpp
         allocators/lockfree-slab-test.cpp
         crc32c-test.cpp
         crypto/aes256-test.cpp
+        crypto/multi-buffer-hashes-test.cpp
         parallel/counter-test.cpp
         parallel/limit-counter-test.cpp
         parallel/maximum-test.cpp
@@ -15,6 +15,7 @@ prepend(COMMON_MAIN_SOURCES ${COMMON_DIR}/
         crypto/aes256.cpp
         crypto/aes256-generic.cpp
         crypto/aes256-${CMAKE_SYSTEM_PROCESSOR}.cpp
+        crypto/multi-buffer-hashes.cpp
 
         fast-backtrace.cpp
         string-processing.cpp
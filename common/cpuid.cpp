@@ -14,8 +14,22 @@ const kdb_cpuid_t *kdb_cpuid() {
     assert(cached.type == KDB_CPUID_X86_64);
     return &cached;
   }
-  int a;
+  int a, b, c, d;
   asm volatile("cpuid\n\t" : "=a"(a), "=b"(cached.x86_64.ebx), "=c"(cached.x86_64.ecx), "=d"(cached.x86_64.edx) : "0"(1));
+
+  cached.x86_64.ext_ebx = 0;
+  asm volatile("cpuid\n\t" : "=a"(a), "=b"(b), "=c"(c), "=d"(d) : "0"(0));
+  if (a >= 7) {
+    asm volatile("cpuid\n\t" : "=a"(a), "=b"(cached.x86_64.ext_ebx), "=c"(c), "=d"(d) : "0"(7), "2"(0));
+    // avx registers are usable only if the OS saves them on context switches: OSXSAVE and the xmm|ymm bits of XCR0
+    unsigned int xcr0_lo = 0, xcr0_hi = 0;
+    if (cached.x86_64.ecx & (1 << 27)) {
+      asm volatile("xgetbv\n\t" : "=a"(xcr0_lo), "=d"(xcr0_hi) : "c"(0));
+    }
+    if ((xcr0_lo & 6) != 6) {
+      cached.x86_64.ext_ebx &= ~(1 << 5);
+    }
+  }
   cached.type = KDB_CPUID_X86_64;
 #elif defined(__arm64__)  // Apple M1
   if (cached.type) {
@@ -13,6 +13,7 @@ typedef struct {
   union {
     struct {
       int ebx, ecx, edx;
+      int ext_ebx; // structured extended feature flags (leaf 7), AVX2 is bit 5; zeroed if the OS doesn't save the ymm state
     } x86_64;
   };
 } kdb_cpuid_t;
@@ -13,6 +13,7 @@
 #include <limits>
 #include <random>
 #include <type_traits>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -306,6 +307,60 @@ TEST(crypto_x86_64_aesni256_set_decrypt_key, basic) {
   }
 }
 
+TEST(crypto_x86_64_aesni256_cbc_decrypt, same_as_generic) {
+  if (crypto_x86_64_has_aesni_extension()) {
+    std::array<std::uint8_t, 32> key;
+    std::array<std::uint8_t, 16> iv;
+    std::vector<std::uint8_t> ciphertext(16 * 40 + 7);
+    std::independent_bits_engine<std::default_random_engine, 8, std::uint8_t> engine;
+    std::generate(key.begin(), key.end(), std::ref(engine));
+    std::generate(iv.begin(), iv.end(), std::ref(engine));
+    std::generate(ciphertext.begin(), ciphertext.end(), std::ref(engine));
+
+    vk_aes_ctx_t generic_ctx, ctx;
+    crypto_generic_aes256_set_decrypt_key(&generic_ctx, key.data());
+    crypto_x86_64_aesni256_set_decrypt_key(&ctx, key.data());
+    // the sizes around the parallel blocks boundaries, also the ones with the incomplete last block that is ignored
+    for (int size : {16, 112, 128, 144, 256, 16 * 23, 16 * 23 + 5, 16 * 40, 16 * 40 + 7}) {
+      auto expected_iv = iv, actual_iv = iv;
+      std::vector<std::uint8_t> expected(size), actual(size);
+      crypto_generic_aes256_cbc_decrypt(&generic_ctx, ciphertext.data(), expected.data(), size & -16, expected_iv.data());
+      crypto_x86_64_aesni256_cbc_decrypt(&ctx, ciphertext.data(), actual.data(), size, actual_iv.data());
+      EXPECT_EQ(expected, actual) << size;
+      EXPECT_EQ(expected_iv, actual_iv) << size;
+
+      std::vector<std::uint8_t> in_place(ciphertext.begin(), ciphertext.begin() + size);
+      actual_iv = iv;
+      crypto_x86_64_aesni256_cbc_decrypt(&ctx, in_place.data(), in_place.data(), size, actual_iv.data());
+      EXPECT_TRUE(std::equal(expected.begin(), expected.begin() + (size & -16), in_place.begin())) << size;
+    }
+  }
+}
+
+TEST(crypto_x86_64_aesni256_ctr_encrypt, same_as_generic) {
+  if (crypto_x86_64_has_aesni_extension()) {
+    std::array<std::uint8_t, 32> key;
+    std::array<std::uint8_t, 16> iv;
+    std::vector<std::uint8_t> payload(16 * 40 + 7);
+    std::independent_bits_engine<std::default_random_engine, 8, std::uint8_t> engine;
+    std::generate(key.begin(), key.end(), std::ref(engine));
+    std::generate(iv.begin(), iv.end(), std::ref(engine));
+    std::generate(payload.begin(), payload.end(), std::ref(engine));
+
+    vk_aes_ctx_t generic_ctx, ctx;
+    crypto_generic_aes256_set_encrypt_key(&generic_ctx, key.data());
+    crypto_x86_64_aesni256_set_encrypt_key(&ctx, key.data());
+    for (int size : {1, 16, 127, 128, 129, 16 * 23 + 5, 16 * 40 + 7}) {
+      for (uint64_t offset : {0, 3, 16, 130}) {
+        std::vector<std::uint8_t> expected(size), actual(size);
+        crypto_generic_aes256_ctr_encrypt(&generic_ctx, payload.data(), expected.data(), size, iv.data(), offset);
+        crypto_x86_64_aesni256_ctr_encrypt(&ctx, payload.data(), actual.data(), size, iv.data(), offset);
+        EXPECT_EQ(expected, actual) << size << " " << offset;
+      }
+    }
+  }
+}
+
 #elif defined(__arm64__)
 
 // no tests for M1, as aes uses generic tables
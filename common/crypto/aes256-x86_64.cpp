@@ -21,6 +21,31 @@ static inline void storedqu(char *out, v16qi v) {
   _mm_storeu_si128((v2di *)out, (v2di)v);
 }
 
+// CBC decryption and CTR process 8 blocks at once: aesenc / aesdec have the latency of several cycles,
+// but a new one can be started every cycle; the blocks are kept in B0..B7 of the caller to stay in registers
+#define AESNI_PARALLEL_BLOCKS 8
+
+// one round for the blocks B0..B7 with the 16-aligned round key
+#define AESNI_ROUND_PARALLEL(insn, key)                                                                                                                \
+  asm(insn " %8, %0\n\t" insn " %8, %1\n\t" insn " %8, %2\n\t" insn " %8, %3\n\t"                                                                 \
+      insn " %8, %4\n\t" insn " %8, %5\n\t" insn " %8, %6\n\t" insn " %8, %7\n\t"                                                                 \
+      : "+x"(B0), "+x"(B1), "+x"(B2), "+x"(B3), "+x"(B4), "+x"(B5), "+x"(B6), "+x"(B7)                                                                \
+      : "m"(*(const v2di *)(key)))
+
+// the round keys are read by the one-block asm through a pointer operand, so the key schedule is passed as a memory input too:
+// without it the compiler doesn't know that asm reads the memory, and may move or drop the stores of the round keys
+#define AESNI_KEY_SCHEDULE(a) "m"(*(const char(*)[15 * 16])(a))
+
+__attribute__((always_inline))
+static inline v2di loadblock(const uint8_t *ptr, int i) {
+  return (v2di)loaddqu((const char *)ptr + 16 * i);
+}
+
+__attribute__((always_inline))
+static inline void storeblock(uint8_t *ptr, int i, v2di v) {
+  storedqu((char *)ptr + 16 * i, (v16qi)v);
+}
+
 bool crypto_x86_64_has_aesni_extension() {
   const kdb_cpuid_t *cpuid = kdb_cpuid();
   assert(cpuid->type == KDB_CPUID_X86_64);
@@ -157,41 +182,61 @@ void crypto_x86_64_aesni256_cbc_encrypt(vk_aes_ctx_t *vk_ctx, const uint8_t *in,
 }
 
 void crypto_x86_64_aesni256_cbc_decrypt(vk_aes_ctx_t *vk_ctx, const uint8_t *in, uint8_t *out, int size, uint8_t iv[16]) {
-  aes256_ctx_t *ctx = &vk_ctx->u.ctx;
-  void *p1, *p2;
   if (size < 16) {
     return;
   }
-  asm volatile("movdqu (%5), %%xmm1\n\t"          // move IV in %xmm1
-               "1:\n\t"                           // start of block processing
-               "subl $0x10, %3\n\t"               // decrease plaintext size on block size
-               "movdqu (%4), %%xmm2\n\t"          // move block of cyphertext to %xmm2
-               "pxor 0xe0(%6), %%xmm2\n\t"        // AddRoundKey
-               "aesdec 0xd0(%6), %%xmm2\n\t"      // 1 round
-               "aesdec 0xc0(%6), %%xmm2\n\t"      // 2 round
-               "aesdec 0xb0(%6), %%xmm2\n\t"      // 3 round
-               "aesdec 0xa0(%6), %%xmm2\n\t"      // ...
-               "aesdec 0x90(%6), %%xmm2\n\t"      // ...
-               "aesdec 0x80(%6), %%xmm2\n\t"      // ...
-               "aesdec 0x70(%6), %%xmm2\n\t"      // ..
-               "aesdec 0x60(%6), %%xmm2\n\t"      // ..
-               "aesdec 0x50(%6), %%xmm2\n\t"      // ..
-               "aesdec 0x40(%6), %%xmm2\n\t"      // ..
-               "aesdec 0x30(%6), %%xmm2\n\t"      // ...
-               "aesdec 0x20(%6), %%xmm2\n\t"      // ...
-               "aesdec 0x10(%6), %%xmm2\n\t"      // ...
-               "aesdeclast 0x00(%6), %%xmm2\n\t"  // 14 round is last for 256 bits key
-               "pxor %%xmm1, %%xmm2\n\t"          // CBC xor
-               "movdqu (%4), %%xmm1\n\t"          // move next block of cyphertext to %xmm1
-               "movdqu %%xmm2, (%7)\n\t"          // move block on plaintext to out
-               "addq $0x10, %4\n\t"               // advance in pointer on block size
-               "addq $0x10, %7\n\t"               // advance out pointer on block size
-               "cmpl $0x0f, %3\n\t"               // do we have more blocks of cyphertext?
-               "jg 1b\n\t"                        // if yes - jump to start of block processing
-               "movdqu %%xmm1, (%5)\n\t"          // move block of cyphertext to IV
-               : "=r"(size), "=r"(p1), "=r"(p2)
-               : "0"(size), "1r"(in), "r"(iv), "r"(align16(ctx)), "2r"(out)
-               : "%xmm1", "%xmm2", "memory");
+  aes256_ctx_t *ctx = &vk_ctx->u.ctx;
+  const char *a = static_cast<const char *>(align16(ctx));
+  v2di IV = (v2di)loaddqu((const char *)iv);
+  // unlike encryption, decryption of a block doesn't depend on the previous one,
+  // so several blocks are decrypted at once to hide the aesdec latency
+  for (; size >= 16 * AESNI_PARALLEL_BLOCKS; size -= 16 * AESNI_PARALLEL_BLOCKS) {
+    const v2di K = *(const v2di *)(a + 0xe0);
+    v2di B0 = loadblock(in, 0) ^ K, B1 = loadblock(in, 1) ^ K, B2 = loadblock(in, 2) ^ K, B3 = loadblock(in, 3) ^ K;
+    v2di B4 = loadblock(in, 4) ^ K, B5 = loadblock(in, 5) ^ K, B6 = loadblock(in, 6) ^ K, B7 = loadblock(in, 7) ^ K;
+    for (int round = 0xd0; round > 0; round -= 0x10) {
+      AESNI_ROUND_PARALLEL("aesdec", a + round);
+    }
+    AESNI_ROUND_PARALLEL("aesdeclast", a);
+    // the ciphertext blocks are reloaded: all of them are decrypted before the stores, so decryption in place is fine
+    const v2di next_IV = loadblock(in, 7);
+    storeblock(out, 7, B7 ^ loadblock(in, 6));
+    storeblock(out, 6, B6 ^ loadblock(in, 5));
+    storeblock(out, 5, B5 ^ loadblock(in, 4));
+    storeblock(out, 4, B4 ^ loadblock(in, 3));
+    storeblock(out, 3, B3 ^ loadblock(in, 2));
+    storeblock(out, 2, B2 ^ loadblock(in, 1));
+    storeblock(out, 1, B1 ^ loadblock(in, 0));
+    storeblock(out, 0, B0 ^ IV);
+    IV = next_IV;
+    in += 16 * AESNI_PARALLEL_BLOCKS;
+    out += 16 * AESNI_PARALLEL_BLOCKS;
+  }
+  for (; size >= 16; size -= 16) {
+    v2di C = (v2di)loaddqu((const char *)in), B;
+    asm("pxor 0xe0(%2), %0\n\t"
+        "aesdec 0xd0(%2), %0\n\t"
+        "aesdec 0xc0(%2), %0\n\t"
+        "aesdec 0xb0(%2), %0\n\t"
+        "aesdec 0xa0(%2), %0\n\t"
+        "aesdec 0x90(%2), %0\n\t"
+        "aesdec 0x80(%2), %0\n\t"
+        "aesdec 0x70(%2), %0\n\t"
+        "aesdec 0x60(%2), %0\n\t"
+        "aesdec 0x50(%2), %0\n\t"
+        "aesdec 0x40(%2), %0\n\t"
+        "aesdec 0x30(%2), %0\n\t"
+        "aesdec 0x20(%2), %0\n\t"
+        "aesdec 0x10(%2), %0\n\t"
+        "aesdeclast 0x00(%2), %0\n\t"
+        : "=x"(B)
+        : "0"(C), "r"(a), AESNI_KEY_SCHEDULE(a));
+    storedqu((char *)out, (v16qi)(B ^ IV));
+    IV = C;
+    in += 16;
+    out += 16;
+  }
+  storedqu((char *)iv, (v16qi)IV);
 }
 
 void crypto_x86_64_aesni256_ige_encrypt(vk_aes_ctx_t *vk_ctx, const uint8_t *in, uint8_t *out, int size, uint8_t iv[32]) {
@@ -221,7 +266,7 @@ void crypto_x86_64_aesni256_ige_encrypt(vk_aes_ctx_t *vk_ctx, const uint8_t *in,
         "aesenc 0xd0(%2), %0\n\t"
         "aesenclast 0xe0(%2), %0\n\t"
         : "=x"(O)
-        : "0"(I ^ Y), "r"(a));
+        : "0"(I ^ Y), "r"(a), AESNI_KEY_SCHEDULE(a));
     Y = O ^ X;
     X = I;
     storedqu((char *) out, Y);
@@ -259,7 +304,7 @@ void crypto_x86_64_aesni256_ige_decrypt(vk_aes_ctx_t *vk_ctx, const uint8_t *in,
         "aesdec 0x10(%2), %0\n\t"
         "aesdeclast 0x00(%2), %0\n\t"
         : "=x"(O)
-        : "0"(I ^ X), "r"(a));
+        : "0"(I ^ X), "r"(a), AESNI_KEY_SCHEDULE(a));
     X = O ^ Y;
     Y = I;
     storedqu((char *)out, X);
@@ -288,8 +333,7 @@ static inline void crypto_x86_64_aesni256_encrypt(uint8_t *ctx, const uint8_t *i
       "aesenc 0xd0(%2), %1\n\t"
       "aesenclast 0xe0(%2), %1\n\t"
       : "=x"(*((v2di *) out))
-      : "0"(*((v2di *) in)), "r"(ctx)
-      :);
+      : "0"(*((v2di *) in)), "r"(ctx), AESNI_KEY_SCHEDULE(ctx));
 }
 
 void crypto_x86_64_aesni256_ctr_encrypt(vk_aes_ctx_t *ctx, const uint8_t *in, uint8_t *out, int size, uint8_t iv[16], uint64_t offset) {
@@ -319,7 +363,27 @@ void crypto_x86_64_aesni256_ctr_encrypt(vk_aes_ctx_t *ctx, const uint8_t *in, ui
         "pshufd $0xcf, %0, %0\n\t"
         : "=x"(INC)
         : "r"(1));
-    do {
+    for (; n >= AESNI_PARALLEL_BLOCKS; n -= AESNI_PARALLEL_BLOCKS) {
+      const v2di K = *(const v2di *)a;
+      v2di B0 = IV ^ K, B1 = (IV + INC) ^ K, B2 = (IV + 2 * INC) ^ K, B3 = (IV + 3 * INC) ^ K;
+      v2di B4 = (IV + 4 * INC) ^ K, B5 = (IV + 5 * INC) ^ K, B6 = (IV + 6 * INC) ^ K, B7 = (IV + 7 * INC) ^ K;
+      IV += 8 * INC;
+      for (int round = 0x10; round < 0xe0; round += 0x10) {
+        AESNI_ROUND_PARALLEL("aesenc", a + round);
+      }
+      AESNI_ROUND_PARALLEL("aesenclast", a + 0xe0);
+      storeblock(out, 0, B0 ^ loadblock(in, 0));
+      storeblock(out, 1, B1 ^ loadblock(in, 1));
+      storeblock(out, 2, B2 ^ loadblock(in, 2));
+      storeblock(out, 3, B3 ^ loadblock(in, 3));
+      storeblock(out, 4, B4 ^ loadblock(in, 4));
+      storeblock(out, 5, B5 ^ loadblock(in, 5));
+      storeblock(out, 6, B6 ^ loadblock(in, 6));
+      storeblock(out, 7, B7 ^ loadblock(in, 7));
+      in += 16 * AESNI_PARALLEL_BLOCKS;
+      out += 16 * AESNI_PARALLEL_BLOCKS;
+    }
+    for (; n > 0; n--) {
       v2di I = (v2di)loaddqu((const char *)in), T;
       asm("pxor (%2), %1\n\t"
           "aesenc 0x10(%2), %1\n\t"
@@ -337,12 +401,12 @@ void crypto_x86_64_aesni256_ctr_encrypt(vk_aes_ctx_t *ctx, const uint8_t *in, ui
           "aesenc 0xd0(%2), %1\n\t"
           "aesenclast 0xe0(%2), %1\n\t"
           : "=x"(T)
-          : "0"(IV), "r"(a));
+          : "0"(IV), "r"(a), AESNI_KEY_SCHEDULE(a));
       in += 16;
       storedqu((char *)out, (v16qi)(I ^ T));
       IV += INC;
       out += 16;
-    } while (--n);
+    }
     *((v2di *)iv_copy) = IV;
   }
 
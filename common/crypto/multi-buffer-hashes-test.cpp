@@ -0,0 +1,91 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#include "common/crypto/multi-buffer-hashes.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "common/md5.h"
+#include "common/sha1.h"
+
+namespace {
+
+template<size_t DIGEST_SIZE, class MultiBufferHash, class SingleHash>
+void check_against_single(const std::vector<std::string> &messages, MultiBufferHash multi_buffer_hash, SingleHash single_hash) {
+  std::vector<const uint8_t *> inputs;
+  std::vector<size_t> lens;
+  for (const auto &message : messages) {
+    inputs.emplace_back(reinterpret_cast<const uint8_t *>(message.data()));
+    lens.emplace_back(message.size());
+  }
+  std::vector<uint8_t> digests(messages.size() * DIGEST_SIZE);
+  multi_buffer_hash(inputs.data(), lens.data(), messages.size(), reinterpret_cast<uint8_t(*)[DIGEST_SIZE]>(digests.data()));
+  for (size_t i = 0; i < messages.size(); ++i) {
+    uint8_t expected[DIGEST_SIZE];
+    single_hash(inputs[i], lens[i], expected);
+    ASSERT_EQ(memcmp(digests.data() + i * DIGEST_SIZE, expected, DIGEST_SIZE), 0) << "message #" << i << " of length " << lens[i];
+  }
+}
+
+std::vector<std::string> gen_messages(std::mt19937 &gen, size_t count, size_t max_len) {
+  std::vector<std::string> messages(count);
+  for (auto &message : messages) {
+    message.resize(gen() % (max_len + 1));
+    for (auto &c : message) {
+      c = static_cast<char>(gen());
+    }
+  }
+  return messages;
+}
+
+} // namespace
+
+TEST(multi_buffer_hashes, known_digests) {
+  const std::vector<std::string> messages{"", "abc", "The quick brown fox jumps over the lazy dog"};
+  std::vector<const uint8_t *> inputs;
+  std::vector<size_t> lens;
+  for (const auto &message : messages) {
+    inputs.emplace_back(reinterpret_cast<const uint8_t *>(message.data()));
+    lens.emplace_back(message.size());
+  }
+
+  uint8_t md5_digests[3][16];
+  md5_multi_buffer(inputs.data(), lens.data(), messages.size(), md5_digests);
+  ASSERT_EQ(md5_digests[0][0], 0xd4);
+  ASSERT_EQ(md5_digests[0][15], 0x7e);
+  ASSERT_EQ(md5_digests[1][0], 0x90);
+  ASSERT_EQ(md5_digests[1][15], 0x72);
+  ASSERT_EQ(md5_digests[2][0], 0x9e);
+  ASSERT_EQ(md5_digests[2][15], 0xd6);
+
+  uint8_t sha1_digests[3][20];
+  sha1_multi_buffer(inputs.data(), lens.data(), messages.size(), sha1_digests);
+  ASSERT_EQ(sha1_digests[0][0], 0xda);
+  ASSERT_EQ(sha1_digests[0][19], 0x09);
+  ASSERT_EQ(sha1_digests[1][0], 0xa9);
+  ASSERT_EQ(sha1_digests[1][19], 0x9d);
+  ASSERT_EQ(sha1_digests[2][0], 0x2f);
+  ASSERT_EQ(sha1_digests[2][19], 0x12);
+}
+
+TEST(multi_buffer_hashes, empty_batch) {
+  md5_multi_buffer(nullptr, nullptr, 0, nullptr);
+  sha1_multi_buffer(nullptr, nullptr, 0, nullptr);
+}
+
+TEST(multi_buffer_hashes, fuzz_against_single_buffer) {
+  std::mt19937 gen{42};
+  // the padding boundaries (55, 56, 63, 64 bytes) and the lanes refilling with messages of different lengths
+  for (size_t count : {1, 3, 4, 5, 8, 9, 17, 100}) {
+    for (size_t max_len : {0, 55, 56, 64, 130, 1000}) {
+      const auto messages = gen_messages(gen, count, max_len);
+      check_against_single<16>(messages, md5_multi_buffer, [](const uint8_t *in, size_t len, uint8_t *out) { md5(const_cast<uint8_t *>(in), len, out); });
+      check_against_single<20>(messages, sha1_multi_buffer, [](const uint8_t *in, size_t len, uint8_t *out) { sha1(const_cast<uint8_t *>(in), len, out); });
+    }
+  }
+}
@@ -0,0 +1,300 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#include "common/crypto/multi-buffer-hashes.h"
+
+#include <cstring>
+
+#include "common/cpuid.h"
+
+namespace {
+
+// the kernels are written with the GCC vector extensions, so they are compiled to SSE2/AVX2 on x86_64 and to NEON on arm
+typedef uint32_t v4u32 __attribute__((vector_size(16)));
+typedef uint32_t v8u32 __attribute__((vector_size(32)));
+
+constexpr size_t BLOCK_SIZE = 64;
+constexpr size_t MAX_LANES = 8;
+
+template<class V>
+__attribute__((always_inline)) inline V rotl(V x, int r) noexcept {
+  return (x << r) | (x >> (32 - r));
+}
+
+inline uint32_t read_le32(const uint8_t *p) noexcept {
+  uint32_t res = 0;
+  memcpy(&res, p, sizeof(res));
+  return res;
+}
+
+struct Md5 {
+  static constexpr size_t STATE_WORDS = 4;
+  static constexpr size_t DIGEST_SIZE = 16;
+  static constexpr bool BIG_ENDIAN_WORDS = false;
+  static constexpr uint32_t IV[STATE_WORDS] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476};
+
+  template<class V>
+  __attribute__((always_inline)) static inline void compress(V *state, const V *w) noexcept {
+    static constexpr uint32_t K[64] = {
+      0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501, 0x698098d8, 0x8b44f7af, 0xffff5bb1,
+      0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821, 0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453,
+      0xd8a1e681, 0xe7d3fbc8, 0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a, 0xfffa3942,
+      0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70, 0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05,
+      0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665, 0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d,
+      0x85845dd1, 0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391};
+    static constexpr int S[4][4] = {{7, 12, 17, 22}, {5, 9, 14, 20}, {4, 11, 16, 23}, {6, 10, 15, 21}};
+
+    V a = state[0], b = state[1], c = state[2], d = state[3];
+#pragma GCC unroll 64
+    for (int i = 0; i < 64; ++i) {
+      V f;
+      int g = 0;
+      if (i < 16) {
+        f = d ^ (b & (c ^ d));
+        g = i;
+      } else if (i < 32) {
+        f = c ^ (d & (b ^ c));
+        g = (5 * i + 1) & 15;
+      } else if (i < 48) {
+        f = b ^ c ^ d;
+        g = (3 * i + 5) & 15;
+      } else {
+        f = c ^ (b | ~d);
+        g = (7 * i) & 15;
+      }
+      const V rotated = rotl(a + f + K[i] + w[g], S[i / 16][i & 3]);
+      a = d;
+      d = c;
+      c = b;
+      b = b + rotated;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+  }
+};
+
+struct Sha1 {
+  static constexpr size_t STATE_WORDS = 5;
+  static constexpr size_t DIGEST_SIZE = 20;
+  static constexpr bool BIG_ENDIAN_WORDS = true;
+  static constexpr uint32_t IV[STATE_WORDS] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+
+  template<class V>
+  __attribute__((always_inline)) static inline void compress(V *state, const V *block) noexcept {
+    V w[16];
+    for (int i = 0; i < 16; ++i) {
+      w[i] = block[i];
+    }
+    V a = state[0], b = state[1], c = state[2], d = state[3], e = state[4];
+#pragma GCC unroll 80
+    for (int i = 0; i < 80; ++i) {
+      if (i >= 16) {
+        w[i & 15] = rotl(w[(i + 13) & 15] ^ w[(i + 8) & 15] ^ w[(i + 2) & 15] ^ w[i & 15], 1);
+      }
+      V f;
+      uint32_t k = 0;
+      if (i < 20) {
+        f = d ^ (b & (c ^ d));
+        k = 0x5a827999;
+      } else if (i < 40) {
+        f = b ^ c ^ d;
+        k = 0x6ed9eba1;
+      } else if (i < 60) {
+        f = (b & c) | (d & (b | c));
+        k = 0x8f1bbcdc;
+      } else {
+        f = b ^ c ^ d;
+        k = 0xca62c1d6;
+      }
+      const V t = rotl(a, 5) + f + e + k + w[i & 15];
+      e = d;
+      d = c;
+      c = rotl(b, 30);
+      b = a;
+      a = t;
+    }
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+    state[4] += e;
+  }
+};
+
+// a message in a lane: its whole blocks are read right from the input, the padded tail is copied
+struct LaneMessage {
+  const uint8_t *data;
+  size_t full_blocks;
+  size_t total_blocks;
+  size_t next_block;
+  size_t index;
+  uint8_t tail[2 * BLOCK_SIZE];
+
+  const uint8_t *block(size_t i) const noexcept {
+    return i < full_blocks ? data + i * BLOCK_SIZE : tail + (i - full_blocks) * BLOCK_SIZE;
+  }
+};
+
+template<class Hash>
+void start_message(LaneMessage &msg, const uint8_t *data, size_t len, size_t index) noexcept {
+  const size_t rest = len % BLOCK_SIZE;
+  msg.data = data;
+  msg.full_blocks = len / BLOCK_SIZE;
+  msg.next_block = 0;
+  msg.index = index;
+
+  // the rest of the message, 0x80, zeros and the 64-bit length in bits at the end of the last block
+  const size_t tail_blocks = rest + 1 + sizeof(uint64_t) <= BLOCK_SIZE ? 1 : 2;
+  memset(msg.tail, 0, tail_blocks * BLOCK_SIZE);
+  if (rest) {
+    memcpy(msg.tail, data + msg.full_blocks * BLOCK_SIZE, rest);
+  }
+  msg.tail[rest] = 0x80;
+  const uint64_t bits = static_cast<uint64_t>(len) * 8;
+  uint8_t *len_pos = msg.tail + tail_blocks * BLOCK_SIZE - sizeof(uint64_t);
+  for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+    len_pos[Hash::BIG_ENDIAN_WORDS ? sizeof(uint64_t) - 1 - i : i] = static_cast<uint8_t>(bits >> (8 * i));
+  }
+  msg.total_blocks = msg.full_blocks + tail_blocks;
+}
+
+template<class Hash, class V>
+__attribute__((always_inline)) inline void hash_lanes(const uint8_t *const *inputs, const size_t *lens, size_t count,
+                                                      uint8_t (*out)[Hash::DIGEST_SIZE]) noexcept {
+  constexpr size_t LANES = sizeof(V) / sizeof(uint32_t);
+  static_assert(LANES <= MAX_LANES, "too many lanes");
+
+  LaneMessage lanes[LANES];
+  bool active[LANES] = {};
+  size_t active_count = 0;
+  size_t next_message = 0;
+
+  alignas(sizeof(V)) uint32_t state_words[Hash::STATE_WORDS][LANES];
+  auto take_next_message = [&](size_t lane) {
+    if (next_message < count) {
+      start_message<Hash>(lanes[lane], inputs[next_message], lens[next_message], next_message);
+      for (size_t k = 0; k < Hash::STATE_WORDS; ++k) {
+        state_words[k][lane] = Hash::IV[k];
+      }
+      ++next_message;
+      if (!active[lane]) {
+        active[lane] = true;
+        ++active_count;
+      }
+    } else if (active[lane]) {
+      active[lane] = false;
+      --active_count;
+    }
+  };
+
+  for (size_t lane = 0; lane < LANES; ++lane) {
+    take_next_message(lane);
+    if (!active[lane]) {
+      // the idle lanes hash the zero block just to be in the same step with the others
+      memset(&lanes[lane], 0, sizeof(LaneMessage));
+      lanes[lane].total_blocks = 1;
+    }
+  }
+
+  alignas(sizeof(V)) uint32_t block_words[16][LANES];
+  while (active_count) {
+    for (size_t lane = 0; lane < LANES; ++lane) {
+      const uint8_t *block = lanes[lane].block(lanes[lane].next_block);
+      for (size_t j = 0; j < 16; ++j) {
+        const uint32_t word = read_le32(block + 4 * j);
+        block_words[j][lane] = Hash::BIG_ENDIAN_WORDS ? __builtin_bswap32(word) : word;
+      }
+    }
+    V state[Hash::STATE_WORDS];
+    V w[16];
+    memcpy(state, state_words, sizeof(state));
+    memcpy(w, block_words, sizeof(w));
+    Hash::compress(state, w);
+    memcpy(state_words, state, sizeof(state));
+
+    for (size_t lane = 0; lane < LANES; ++lane) {
+      if (!active[lane] || ++lanes[lane].next_block != lanes[lane].total_blocks) {
+        continue;
+      }
+      uint8_t *digest = out[lanes[lane].index];
+      for (size_t k = 0; k < Hash::STATE_WORDS; ++k) {
+        const uint32_t word = Hash::BIG_ENDIAN_WORDS ? __builtin_bswap32(state_words[k][lane]) : state_words[k][lane];
+        memcpy(digest + 4 * k, &word, sizeof(word));
+      }
+      take_next_message(lane);
+      if (!active[lane]) {
+        lanes[lane].full_blocks = 0;
+        lanes[lane].next_block = 0;
+      }
+    }
+  }
+}
+
+using md5_kernel_t = void (*)(const uint8_t *const *inputs, const size_t *lens, size_t count, uint8_t (*out)[16]) noexcept;
+using sha1_kernel_t = void (*)(const uint8_t *const *inputs, const size_t *lens, size_t count, uint8_t (*out)[20]) noexcept;
+
+struct Kernels {
+  md5_kernel_t md5;
+  sha1_kernel_t sha1;
+};
+
+void md5_4_lanes(const uint8_t *const *inputs, const size_t *lens, size_t count, uint8_t (*out)[16]) noexcept {
+  hash_lanes<Md5, v4u32>(inputs, lens, count, out);
+}
+
+void sha1_4_lanes(const uint8_t *const *inputs, const size_t *lens, size_t count, uint8_t (*out)[20]) noexcept {
+  hash_lanes<Sha1, v4u32>(inputs, lens, count, out);
+}
+
+} // namespace
+
+#ifdef __x86_64__
+
+namespace {
+
+__attribute__((target("avx2")))
+void md5_8_lanes_avx2(const uint8_t *const *inputs, const size_t *lens, size_t count, uint8_t (*out)[16]) noexcept {
+  hash_lanes<Md5, v8u32>(inputs, lens, count, out);
+}
+
+__attribute__((target("avx2")))
+void sha1_8_lanes_avx2(const uint8_t *const *inputs, const size_t *lens, size_t count, uint8_t (*out)[20]) noexcept {
+  hash_lanes<Sha1, v8u32>(inputs, lens, count, out);
+}
+
+const Kernels &get_kernels() noexcept {
+  static const Kernels kernels = [] {
+    const kdb_cpuid_t *cpuid = kdb_cpuid();
+    if (cpuid->x86_64.ext_ebx & (1 << 5)) {
+      return Kernels{md5_8_lanes_avx2, sha1_8_lanes_avx2};
+    }
+    return Kernels{md5_4_lanes, sha1_4_lanes};
+  }();
+  return kernels;
+}
+
+} // namespace
+
+#else
+
+namespace {
+
+const Kernels &get_kernels() noexcept {
+  static const Kernels kernels{md5_4_lanes, sha1_4_lanes};
+  return kernels;
+}
+
+} // namespace
+
+#endif
+
+void md5_multi_buffer(const uint8_t *const *inputs, const size_t *lens, size_t count, uint8_t (*out)[16]) noexcept {
+  get_kernels().md5(inputs, lens, count, out);
+}
+
+void sha1_multi_buffer(const uint8_t *const *inputs, const size_t *lens, size_t count, uint8_t (*out)[20]) noexcept {
+  get_kernels().sha1(inputs, lens, count, out);
+}
@@ -0,0 +1,19 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// multi-buffer md5 and sha1: independent messages are hashed in SIMD lanes side by side,
+// a lane takes the next message as soon as its current one is finished;
+// 8 lanes with AVX2 (chosen at runtime with kdb_cpuid()), 4 lanes otherwise.
+// It pays off for many short messages, where the single-buffer code can't use SIMD at all
+
+// out[i] = md5(inputs[i], lens[i]) for all i < count
+void md5_multi_buffer(const uint8_t *const *inputs, const size_t *lens, size_t count, uint8_t (*out)[16]) noexcept;
+
+// out[i] = sha1(inputs[i], lens[i]) for all i < count
+void sha1_multi_buffer(const uint8_t *const *inputs, const size_t *lens, size_t count, uint8_t (*out)[20]) noexcept;
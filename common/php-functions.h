@@ -10,6 +10,7 @@
 #include <limits>
 #include <type_traits>
 
+#include "common/algorithms/number-conversions.h"
 #include "common/sanitizer.h"
 
 constexpr int STRLEN_WARNING_FLAG = 1 << 30;
@@ -169,12 +170,7 @@ bool php_is_int(const char *s, size_t l) {
     return val <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + has_minus;
   }
 
-  for (size_t j = 1; j < l; j++) {
-    if (s[j] > '9' || s[j] < '0') {
-      return false;
-    }
-  }
-  return true;
+  return are_all_digits(s + 1, l - 1);
 }
 
 
@@ -221,7 +217,15 @@ bool php_try_to_int(const char *s, size_t l, int64_t *val) {
   }
 
   *val = s[0] - '0';
-  for (size_t j = 1; j < l; j++) {
+  size_t j = 1;
+  for (; j + 8 <= l; j += 8) {
+    const uint64_t chunk = load_8_chars(s + j);
+    if (!are_8_digits(chunk)) {
+      return false;
+    }
+    *val = *val * 100000000 + parse_8_digits(chunk);
+  }
+  for (; j < l; j++) {
     if (s[j] > '9' || s[j] < '0') {
       return false;
     }
@@ -60,8 +60,13 @@ void VarDeclaration::compile(CodeGenerator &W) const {
   W << ";" << NL;
   if (var->needs_const_iterator_flag) {
     for (const auto &name : {"$it", "$it$end"}) {
-      W << (extern_flag ? "extern " : "") <<
-        "decltype(const_begin(" << VarName(var) << "))" << " " << VarName(var) << name << ";" << NL;
+      W << (extern_flag ? "extern " : "");
+      if (var->is_list_array) {
+        W << "decltype(" << VarName(var) << ".get_const_vector_pointer())";
+      } else {
+        W << "decltype(const_begin(" << VarName(var) << "))";
+      }
+      W << " " << VarName(var) << name << ";" << NL;
     }
   }
 
@@ -42,6 +42,13 @@ add_executable({0} EXCLUDE_FROM_ALL ${{SRC_FILES}})
 target_include_directories({0} PRIVATE . ${{AUTO_DIR}}/runtime/)
 target_link_libraries({0} PRIVATE ${{RUNTIME_LIBS}} ${{RUNTIME_LINK_TEST_LIBS}}))cmake", target_name);
 
+  // --cxx-profile-generate / --cxx-profile-use
+  if (const std::string &pgo_flags = G->settings().cxx_pgo_flags.get(); !pgo_flags.empty()) {
+    W << fmt_format(R"cmake(
+target_compile_options({0} PRIVATE {1})
+target_link_options({0} PRIVATE {1}))cmake", target_name, pgo_flags);
+  }
+
   W << CloseFile{};
 }
 
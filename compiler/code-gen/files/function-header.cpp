@@ -39,6 +39,11 @@ void FunctionH::compile(CodeGenerator &W) const {
   if (function->is_flatten) {
     W << " __attribute__((flatten))";
   }
+  if (function->profile_hotness == FunctionData::profile_hotness_t::hot) {
+    W << " __attribute__((hot))";
+  } else if (function->profile_hotness == FunctionData::profile_hotness_t::cold) {
+    W << " __attribute__((cold))";
+  }
   W << ";" << NL;
   if (function->is_resumable) {
     W << FunctionForkDeclaration(function, true) << ";" << NL;
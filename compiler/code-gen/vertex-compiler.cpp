@@ -862,7 +862,15 @@ void compile_func_call(VertexAdaptor<op_func_call> root, CodeGenerator &W, func_
     }
   }
 
-  W << JoinValues(args, ", ");
+  if (root->devirtualized_from && !args.empty()) {
+    // a direct call instead of a virtual dispatcher must still fail on a null receiver, see devirtualize-calls.cpp
+    W << "check_not_null_receiver(" << args[0] << ", " << RawString(root->devirtualized_from->as_human_readable()) << ")";
+    for (int i = 1; i < args.size(); ++i) {
+      W << ", " << args[i];
+    }
+  } else {
+    W << JoinValues(args, ", ");
+  }
   W << ")";
 }
 
@@ -1027,6 +1035,19 @@ void compile_foreach_ref_header(VertexAdaptor<op_foreach> root, CodeGenerator &W
   }
 }
 
+// a list is a vector, so it's iterated by a plain pointer, and a key is an offset
+void compile_foreach_over_list_header(VertexAdaptor<op_var> temp_var, VertexPtr x, VertexPtr key, CodeGenerator &W) {
+  W << temp_var << "$it = " << temp_var << ".get_const_vector_pointer();" << NL;
+  W << temp_var << "$it$end = " << temp_var << "$it + " << temp_var << ".count();" << NL;
+  W << "for (; " << temp_var << "$it != " << temp_var << "$it$end; ++" << temp_var << "$it) " <<
+    BEGIN;
+
+  W << x << " = *" << temp_var << "$it;" << NL;
+  if (key) {
+    W << key << " = " << temp_var << ".count() - (" << temp_var << "$it$end - " << temp_var << "$it);" << NL;
+  }
+}
+
 void compile_foreach_noref_header(VertexAdaptor<op_foreach> root, CodeGenerator &W) {
   auto params = root->params();
   //foreach (xs as [key =>] x)
@@ -1052,6 +1073,10 @@ void compile_foreach_noref_header(VertexAdaptor<op_foreach> root, CodeGenerator
   W << BEGIN;
   //save array to 'xs_copy_str'
   W << temp_var << " = " << xs << ";" << NL;
+  if (temp_var->var_id->is_list_array) {
+    compile_foreach_over_list_header(temp_var, x, key, W);
+    return;
+  }
   W << temp_var << "$it = const_begin(" << temp_var << ");" << NL;
   W << temp_var << "$it$end = const_end(" << temp_var << ");" << NL;
   W << "for (; " << temp_var << "$it != " << temp_var << "$it$end; ++" << temp_var << "$it) " <<
@@ -1695,11 +1720,20 @@ bool try_compile_append_inplace(VertexAdaptor<op_set_dot> root, CodeGenerator &W
   return false;
 }
 
+bool is_list_var(VertexPtr v) {
+  auto var = v.try_as<op_var>();
+  return var && var->var_id && var->var_id->is_list_array;
+}
+
 void compile_index_of_array(VertexAdaptor<op_index> root, CodeGenerator &W) {
   bool used_as_rval = root->rl_type != val_l;
   if (!used_as_rval) {
     kphp_assert(root->has_key());
     W << root->array() << "[" << root->key() << "]";
+  } else if (const TypeData *key_type = tinf::get_type(root->key());
+             is_list_var(root->array()) && key_type->ptype() == tp_int && !key_type->use_optional()) {
+    // int|false and ?int keys go through get_value(): false and null are converted to keys the PHP way
+    W << root->array() << ".get_list_value(" << root->key() << ")";
   } else {
     W << root->array() << ".get_value (" << root->key();
     // if it's a const string key access like $a['somekey'],
@@ -1896,6 +1930,10 @@ void compile_array(VertexAdaptor<op_array> root, CodeGenerator &W) {
     END << ")";
 }
 
+void compile_array_refill(VertexAdaptor<op_array_refill> root, CodeGenerator &W) {
+  W << root->var() << ".refill_vector(" << JoinValues(*root->array(), ", ") << ")";
+}
+
 void compile_tuple(VertexAdaptor<op_tuple> root, CodeGenerator &W) {
   W << "std::make_tuple(" << JoinValues(root->args(), ", ") << ")";
 }
@@ -2212,6 +2250,9 @@ void compile_common_op(VertexPtr root, CodeGenerator &W) {
     case op_array:
       compile_array(root.as<op_array>(), W);
       break;
+    case op_array_refill:
+      compile_array_refill(root.as<op_array_refill>(), W);
+      break;
     case op_tuple:
       compile_tuple(root.as<op_tuple>(), W);
       break;
@@ -0,0 +1,388 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#include "compiler/compile-time-eval.h"
+
+#include <functional>
+#include <openssl/evp.h>
+#include <unordered_map>
+
+#include "common/crc32.h"
+#include "common/php-functions.h"
+#include "common/wrappers/string_view.h"
+#include "compiler/data/function-data.h"
+#include "compiler/vertex-util.h"
+
+namespace {
+
+// limits not to blow up the binary with huge literals, str_repeat('x', 1 << 30) is better left for the runtime
+constexpr size_t MAX_EVAL_STRING_LEN = 1 << 16;
+constexpr size_t MAX_EVAL_ARRAY_SIZE = 1 << 12;
+
+// a subset of php values, that is enough for the supported builtins: arrays are flat, with int or string values
+struct ConstValue {
+  enum class kind_t { integer, string, array };
+
+  kind_t kind{kind_t::integer};
+  int64_t int_val{0};
+  std::string str_val;
+  std::vector<ConstValue> keys;
+  std::vector<ConstValue> values;
+  int64_t next_index{0};
+
+  static ConstValue of_int(int64_t i) {
+    ConstValue value;
+    value.int_val = i;
+    return value;
+  }
+
+  static ConstValue of_string(std::string s) {
+    ConstValue value;
+    value.kind = kind_t::string;
+    value.str_val = std::move(s);
+    return value;
+  }
+
+  static ConstValue of_array() {
+    ConstValue value;
+    value.kind = kind_t::array;
+    return value;
+  }
+
+  bool is_int() const { return kind == kind_t::integer; }
+  bool is_string() const { return kind == kind_t::string; }
+  bool is_array() const { return kind == kind_t::array; }
+
+  std::string to_string() const {
+    return is_int() ? std::to_string(int_val) : str_val;
+  }
+
+  bool is_same_key(const ConstValue &other) const {
+    return kind == other.kind && int_val == other.int_val && str_val == other.str_val;
+  }
+
+  // the same conversion as in runtime array: "123" becomes an int key, but "0123" and "-0" remain strings
+  static ConstValue normalize_key(const ConstValue &key) {
+    int64_t int_key = 0;
+    if (key.is_int() || !php_try_to_int(key.str_val.data(), key.str_val.size(), &int_key)) {
+      return key;
+    }
+    return of_int(int_key);
+  }
+
+  void set(const ConstValue &key, ConstValue value) {
+    ConstValue normalized = normalize_key(key);
+    for (size_t i = 0; i < keys.size(); ++i) {
+      if (keys[i].is_same_key(normalized)) {
+        values[i] = std::move(value);
+        return;
+      }
+    }
+    if (normalized.is_int() && normalized.int_val >= next_index) {
+      next_index = normalized.int_val + 1;
+    }
+    keys.emplace_back(std::move(normalized));
+    values.emplace_back(std::move(value));
+  }
+
+  void push_back(ConstValue value) {
+    set(of_int(next_index), std::move(value));
+  }
+};
+
+bool extract_value(VertexPtr v, ConstValue &out, bool is_call_arg = true);
+
+bool extract_array(VertexAdaptor<op_array> v, ConstValue &out) {
+  if (static_cast<size_t>(v->size()) > MAX_EVAL_ARRAY_SIZE) {
+    return false;
+  }
+  out = ConstValue::of_array();
+  for (auto item : *v) {
+    ConstValue value;
+    if (auto arrow = item.try_as<op_double_arrow>()) {
+      ConstValue key;
+      if (!extract_value(arrow->key(), key, false) || !extract_value(arrow->value(), value, false)) {
+        return false;
+      }
+      out.set(key, std::move(value));
+    } else {
+      if (!extract_value(item, value, false)) {
+        return false;
+      }
+      out.push_back(std::move(value));
+    }
+  }
+  return true;
+}
+
+bool extract_value(VertexPtr v, ConstValue &out, bool is_call_arg) {
+  v = VertexUtil::get_actual_value(v);
+  switch (v->type()) {
+    case op_int_const:
+      out = ConstValue::of_int(parse_int_from_string(v.as<op_int_const>()));
+      return true;
+    case op_minus:
+      if (auto int_const = VertexUtil::get_actual_value(v.as<op_minus>()->expr()).try_as<op_int_const>()) {
+        out = ConstValue::of_int(-parse_int_from_string(int_const));
+        return true;
+      }
+      return false;
+    case op_true:
+    case op_false:
+      // implode() would convert false to "", not to "0", that's why bools are only allowed as plain arguments (md5($s, false))
+      out = ConstValue::of_int(v->type() == op_true);
+      return is_call_arg;
+    case op_string:
+      out = ConstValue::of_string(v->get_string());
+      return true;
+    case op_conv_string:
+      if (!extract_value(v.as<op_conv_string>()->expr(), out, false)) {
+        return false;
+      }
+      out = ConstValue::of_string(out.to_string());
+      return true;
+    case op_conv_array:
+      return is_call_arg && extract_value(v.as<op_conv_array>()->expr(), out, true) && out.is_array();
+    case op_array:
+      return is_call_arg && extract_array(v.as<op_array>(), out);
+    default:
+      return false;
+  }
+}
+
+VertexPtr mark_const(VertexPtr v) {
+  v->const_type = cnst_const_val;
+  for (auto child : *v) {
+    mark_const(child);
+  }
+  return v;
+}
+
+VertexPtr create_scalar_vertex(const ConstValue &value) {
+  return value.is_int() ? VertexUtil::create_int_const(value.int_val) : VertexUtil::create_string_const(value.str_val);
+}
+
+// builtins like array_keys() are declared to return mixed[], the evaluated literal must have the same type
+VertexPtr create_vertex(const ConstValue &value, bool mixed_values = false) {
+  if (!value.is_array()) {
+    return create_scalar_vertex(value);
+  }
+  std::vector<VertexPtr> items;
+  bool is_vector = true;
+  for (size_t i = 0; i < value.keys.size(); ++i) {
+    is_vector &= value.keys[i].is_int() && value.keys[i].int_val == static_cast<int64_t>(i);
+  }
+  for (size_t i = 0; i < value.keys.size(); ++i) {
+    VertexPtr item = create_scalar_vertex(value.values[i]);
+    if (mixed_values) {
+      item = VertexUtil::create_conv_to(tp_mixed, item);
+    }
+    if (!is_vector) {
+      item = VertexAdaptor<op_double_arrow>::create(create_scalar_vertex(value.keys[i]), item);
+    }
+    items.emplace_back(item);
+  }
+  return VertexAdaptor<op_array>::create(items);
+}
+
+std::string to_hex(const unsigned char *digest, size_t len) {
+  static const char hex_digits[] = "0123456789abcdef";
+  std::string res(len * 2, '\0');
+  for (size_t i = 0; i < len; ++i) {
+    res[2 * i] = hex_digits[digest[i] >> 4];
+    res[2 * i + 1] = hex_digits[digest[i] & 15];
+  }
+  return res;
+}
+
+std::string trim_chars(const std::string &s, const std::string &what, bool left, bool right) {
+  size_t l = 0;
+  size_t r = s.size();
+  while (left && l < r && what.find(s[l]) != std::string::npos) {
+    ++l;
+  }
+  while (right && r > l && what.find(s[r - 1]) != std::string::npos) {
+    --r;
+  }
+  return s.substr(l, r - l);
+}
+
+using Args = std::vector<ConstValue>;
+// returns false if the call can't be evaluated with these arguments
+using Evaluator = std::function<bool(const Args &args, ConstValue &result)>;
+
+struct BuiltinEvaluator {
+  size_t min_args;
+  size_t max_args;
+  bool returns_mixed_values;
+  Evaluator eval;
+};
+
+Evaluator string_transform(std::function<std::string(std::string)> transform) {
+  return [transform](const Args &args, ConstValue &result) {
+    if (!args[0].is_string()) {
+      return false;
+    }
+    result = ConstValue::of_string(transform(args[0].str_val));
+    return true;
+  };
+}
+
+Evaluator trim_evaluator(bool left, bool right) {
+  return [left, right](const Args &args, ConstValue &result) {
+    static const std::string default_what(" \n\r\t\v\0", 6);
+    // ranges like "a..z" are rarely used in constant expressions, leave them for the runtime
+    if (!args[0].is_string() || (args.size() > 1 && (!args[1].is_string() || args[1].str_val.find("..") != std::string::npos))) {
+      return false;
+    }
+    result = ConstValue::of_string(trim_chars(args[0].str_val, args.size() > 1 ? args[1].str_val : default_what, left, right));
+    return true;
+  };
+}
+
+Evaluator hash_evaluator(const EVP_MD *(*get_evp)()) {
+  return [get_evp](const Args &args, ConstValue &result) {
+    // raw output is rarely needed, and a binary string is not nice in the generated code
+    if (!args[0].is_string() || (args.size() > 1 && !(args[1].is_int() && args[1].int_val == 0))) {
+      return false;
+    }
+    unsigned char digest[EVP_MAX_MD_SIZE];
+    unsigned int digest_len = 0;
+    if (!EVP_Digest(args[0].str_val.data(), args[0].str_val.size(), digest, &digest_len, get_evp(), nullptr)) {
+      return false;
+    }
+    result = ConstValue::of_string(to_hex(digest, digest_len));
+    return true;
+  };
+}
+
+const std::unordered_map<vk::string_view, BuiltinEvaluator> &get_builtin_evaluators() {
+  static const std::unordered_map<vk::string_view, BuiltinEvaluator> evaluators = {
+    {"strtolower", {1, 1, false, string_transform([](std::string s) {
+      std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c; });
+      return s;
+    })}},
+    {"strtoupper", {1, 1, false, string_transform([](std::string s) {
+      std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return c >= 'a' && c <= 'z' ? c - ('a' - 'A') : c; });
+      return s;
+    })}},
+    {"ucfirst", {1, 1, false, string_transform([](std::string s) {
+      if (!s.empty() && s[0] >= 'a' && s[0] <= 'z') {
+        s[0] -= 'a' - 'A';
+      }
+      return s;
+    })}},
+    {"lcfirst", {1, 1, false, string_transform([](std::string s) {
+      if (!s.empty() && s[0] >= 'A' && s[0] <= 'Z') {
+        s[0] += 'a' - 'A';
+      }
+      return s;
+    })}},
+    {"strrev", {1, 1, false, string_transform([](std::string s) {
+      std::reverse(s.begin(), s.end());
+      return s;
+    })}},
+    {"trim", {1, 2, false, trim_evaluator(true, true)}},
+    {"ltrim", {1, 2, false, trim_evaluator(true, false)}},
+    {"rtrim", {1, 2, false, trim_evaluator(false, true)}},
+    {"md5", {1, 2, false, hash_evaluator(EVP_md5)}},
+    {"sha1", {1, 2, false, hash_evaluator(EVP_sha1)}},
+    {"crc32", {1, 1, false, [](const Args &args, ConstValue &result) {
+      if (!args[0].is_string()) {
+        return false;
+      }
+      result = ConstValue::of_int(compute_crc32(args[0].str_val.data(), args[0].str_val.size()));
+      return true;
+    }}},
+    {"strlen", {1, 1, false, [](const Args &args, ConstValue &result) {
+      if (!args[0].is_string()) {
+        return false;
+      }
+      result = ConstValue::of_int(args[0].str_val.size());
+      return true;
+    }}},
+    {"str_repeat", {2, 2, false, [](const Args &args, ConstValue &result) {
+      if (!args[0].is_string() || !args[1].is_int() || args[1].int_val < 0 ||
+          (!args[0].str_val.empty() && args[1].int_val > static_cast<int64_t>(MAX_EVAL_STRING_LEN / args[0].str_val.size()))) {
+        return false;
+      }
+      std::string res;
+      // an empty string is repeated without iterating, the count may be huge
+      for (int64_t i = 0; !args[0].str_val.empty() && i < args[1].int_val; ++i) {
+        res += args[0].str_val;
+      }
+      result = ConstValue::of_string(std::move(res));
+      return true;
+    }}},
+    {"implode", {2, 2, false, [](const Args &args, ConstValue &result) {
+      if (!args[0].is_string() || !args[1].is_array()) {
+        return false;
+      }
+      std::string res;
+      for (size_t i = 0; i < args[1].values.size(); ++i) {
+        res += (i ? args[0].str_val : std::string{}) + args[1].values[i].to_string();
+      }
+      result = ConstValue::of_string(std::move(res));
+      return true;
+    }}},
+    {"array_flip", {1, 1, true, [](const Args &args, ConstValue &result) {
+      if (!args[0].is_array()) {
+        return false;
+      }
+      result = ConstValue::of_array();
+      for (size_t i = 0; i < args[0].keys.size(); ++i) {
+        result.set(args[0].values[i], args[0].keys[i]);
+      }
+      return true;
+    }}},
+    {"array_keys", {1, 1, true, [](const Args &args, ConstValue &result) {
+      if (!args[0].is_array()) {
+        return false;
+      }
+      result = ConstValue::of_array();
+      for (const auto &key : args[0].keys) {
+        result.push_back(key);
+      }
+      return true;
+    }}},
+  };
+  return evaluators;
+}
+
+} // namespace
+
+VertexPtr try_eval_builtin_call(VertexAdaptor<op_func_call> call) {
+  FunctionPtr function = call->func_id;
+  if (!function || !function->is_extern()) {
+    return {};
+  }
+  const auto &evaluators = get_builtin_evaluators();
+  auto it = evaluators.find(vk::string_view{function->name});
+  if (it == evaluators.end()) {
+    return {};
+  }
+  const BuiltinEvaluator &evaluator = it->second;
+  const size_t n_args = call->args().size();
+  if (n_args < evaluator.min_args || n_args > evaluator.max_args) {
+    return {};
+  }
+
+  Args args(n_args);
+  for (size_t i = 0; i < n_args; ++i) {
+    if (!extract_value(call->args()[i], args[i])) {
+      return {};
+    }
+  }
+  ConstValue result;
+  if (!evaluator.eval(args, result)) {
+    return {};
+  }
+  if ((result.is_string() && result.str_val.size() > MAX_EVAL_STRING_LEN) || (result.is_array() && result.keys.size() > MAX_EVAL_ARRAY_SIZE)) {
+    return {};
+  }
+
+  VertexPtr evaluated = create_vertex(result, evaluator.returns_mixed_values);
+  evaluated.set_location_recursively(call);
+  return mark_const(evaluated);
+}
@@ -0,0 +1,15 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#pragma once
+
+#include "compiler/vertex.h"
+
+// some pure builtins called with constant arguments are evaluated by the compiler itself:
+// implode(',', ['a', 'b']) is replaced with 'a,b', md5('salt') — with a string of a hash, array_flip(self::MAP) — with an array literal;
+// such literals are then extracted into const vars (see CollectConstVarsPass), so no runtime work is done at all
+//
+// only a small whitelist of builtins is supported, their behaviour must exactly match runtime/ implementations;
+// returns an empty VertexPtr if the call can't be evaluated (an unknown function, non-constant arguments, too big result)
+VertexPtr try_eval_builtin_call(VertexAdaptor<op_func_call> call);
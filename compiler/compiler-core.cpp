@@ -621,6 +621,12 @@ void CompilerCore::try_load_tl_classes() {
   }
 }
 
+void CompilerCore::try_load_function_profile() {
+  if (!settings().function_profile_file.get().empty()) {
+    function_profile.load_from(settings().function_profile_file.get());
+  }
+}
+
 void CompilerCore::init_composer_class_loader() {
   if (!settings().is_composer_enabled()) {
     return;
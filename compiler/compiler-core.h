@@ -24,6 +24,7 @@
 #include "compiler/tl-classes.h"
 #include "compiler/composer.h"
 #include "compiler/function-colors.h"
+#include "compiler/function-profile.h"
 
 class CompilerCore {
 private:
@@ -43,6 +44,7 @@ private:
   FFIRoot ffi;
   ClassPtr memcache_class;
   TlClasses tl_classes;
+  FunctionProfile function_profile;
   std::vector<std::string> kphp_runtime_opts;
   bool is_untyped_rpc_tl_used{false};
   bool is_functions_txt_parsed{false};
@@ -127,6 +129,9 @@ public:
   void init_composer_class_loader();
   const TlClasses &get_tl_classes() const { return tl_classes; }
 
+  void try_load_function_profile();
+  const FunctionProfile &get_function_profile() const { return function_profile; }
+
   void add_kphp_runtime_opt(std::string opt) { kphp_runtime_opts.emplace_back(std::move(opt)); }
   const std::vector<std::string> &get_kphp_runtime_opts() const { return kphp_runtime_opts; }
 
@@ -313,6 +313,27 @@ void CompilerSettings::init() {
     #error unsupported __cplusplus value
   #endif
 
+  if (!cxx_profile_generate_dir.get().empty() && !cxx_profile_use_dir.get().empty()) {
+    throw std::runtime_error{"Options " + cxx_profile_generate_dir.get_env_var() + " and " + cxx_profile_use_dir.get_env_var() + " are mutually exclusive"};
+  }
+  if (!cxx_profile_generate_dir.get().empty()) {
+    mkdir_recursive(cxx_profile_generate_dir.get().c_str(), 0777);
+    cxx_pgo_flags.value_ = "-fprofile-generate=" + get_full_path(cxx_profile_generate_dir.get());
+  } else if (!cxx_profile_use_dir.get().empty()) {
+    const std::string profile_dir = get_full_path(cxx_profile_use_dir.get());
+    if (profile_dir.empty()) {
+      throw std::runtime_error{fmt_format("Failed to open profile directory [{}] : {}", cxx_profile_use_dir.get(), strerror(errno))};
+    }
+    cxx_pgo_flags.value_ = "-fprofile-use=" + profile_dir;
+    // a profile is usually collected from a previous revision of a site, some functions are new or changed
+    if (!vk::contains(cxx.get(), "clang")) {
+      cxx_pgo_flags.value_ += " -fprofile-partial-training -Wno-missing-profile -Wno-coverage-mismatch";
+    }
+  }
+  if (!cxx_pgo_flags.get().empty()) {
+    ss << " " << cxx_pgo_flags.get();
+  }
+
   std::string cxx_default_flags = ss.str();
 
   cxx_toolchain_option.value_ = !cxx_toolchain_dir.value_.empty() ? ("-B" + cxx_toolchain_dir.value_) : "";
@@ -321,6 +342,10 @@ void CompilerSettings::init() {
   remove_extra_spaces(extra_ld_flags.value_);
 
   ld_flags.value_ = extra_ld_flags.get();
+  if (!cxx_profile_generate_dir.get().empty()) {
+    // links libgcov
+    ld_flags.value_ += " " + cxx_pgo_flags.get();
+  }
   append_curl(cxx_default_flags, ld_flags.value_);
   append_apple_options(cxx_default_flags, ld_flags.value_);
   std::vector<vk::string_view> external_static_libs{"pcre", "re2", "yaml-cpp", "h3", "z", "zstd", "nghttp2", "kphp-timelib"};
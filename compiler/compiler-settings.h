@@ -154,8 +154,11 @@ public:
   KphpOption<std::string> extra_cxx_debug_level;
   KphpOption<std::string> archive_creator;
   KphpOption<bool> dynamic_incremental_linkage;
+  KphpOption<std::string> cxx_profile_generate_dir;
+  KphpOption<std::string> cxx_profile_use_dir;
 
   KphpOption<uint64_t> profiler_level;
+  KphpOption<std::string> function_profile_file;
   KphpOption<bool> enable_global_vars_memory_stats;
   KphpOption<bool> enable_full_performance_analyze;
   KphpOption<bool> print_resumable_graph;
@@ -177,6 +180,7 @@ public:
   KphpImplicitOption generated_runtime_path;
   KphpImplicitOption performance_analyze_report_path;
   KphpImplicitOption cxx_toolchain_option;
+  KphpImplicitOption cxx_pgo_flags;
 
   KphpImplicitOption runtime_headers;
   KphpImplicitOption runtime_sha256;
@@ -136,6 +136,7 @@ prepend(KPHP_COMPILER_PIPES_SOURCES pipes/
         convert-list-assignments.cpp
         convert-sprintf-calls.cpp
         deduce-implicit-types-and-casts.cpp
+        devirtualize-calls.cpp
         erase-defines-declarations.cpp
         extract-async.cpp
         extract-resumable-calls.cpp
@@ -145,11 +146,15 @@ prepend(KPHP_COMPILER_PIPES_SOURCES pipes/
         fix-returns.cpp
         gen-tree-postprocess.cpp
         generate-virtual-methods.cpp
+        hoist-pure-expressions.cpp
+        infer-list-arrays.cpp
         inline-defines-usages.cpp
         inline-simple-functions.cpp
         instantiate-generics-and-lambdas.cpp
         instantiate-ffi-operations.cpp
         load-files.cpp
+        lower-arrays-to-shapes.cpp
+        move-last-usages.cpp
         early-optimization.cpp
         optimization.cpp
         parse.cpp
@@ -164,6 +169,7 @@ prepend(KPHP_COMPILER_PIPES_SOURCES pipes/
         register-ffi-scopes.cpp
         remove-empty-function-calls.cpp
         resolve-self-static-parent.cpp
+        reuse-array-literals.cpp
         sort-and-inherit-classes.cpp
         split-switch.cpp
         transform-to-smart-instanceof.cpp
@@ -195,7 +201,9 @@ prepend(KPHP_COMPILER_SOURCES ${KPHP_COMPILER_DIR}/
         cpp-dest-dir-initializer.cpp
         debug.cpp
         compiler-settings.cpp
+        compile-time-eval.cpp
         function-colors.cpp
+        function-profile.cpp
         gentree.cpp
         vertex-util.cpp
         generics-reification.cpp
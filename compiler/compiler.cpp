@@ -68,11 +68,16 @@
 #include "compiler/pipes/gen-tree-postprocess.h"
 #include "compiler/pipes/generate-virtual-methods.h"
 #include "compiler/pipes/deduce-implicit-types-and-casts.h"
+#include "compiler/pipes/devirtualize-calls.h"
+#include "compiler/pipes/hoist-pure-expressions.h"
+#include "compiler/pipes/infer-list-arrays.h"
 #include "compiler/pipes/instantiate-generics-and-lambdas.h"
 #include "compiler/pipes/instantiate-ffi-operations.h"
 #include "compiler/pipes/inline-defines-usages.h"
 #include "compiler/pipes/inline-simple-functions.h"
 #include "compiler/pipes/load-files.h"
+#include "compiler/pipes/lower-arrays-to-shapes.h"
+#include "compiler/pipes/move-last-usages.h"
 #include "compiler/pipes/optimization.h"
 #include "compiler/pipes/early-optimization.h"
 #include "compiler/pipes/parse-and-apply-phpdoc.h"
@@ -87,6 +92,7 @@
 #include "compiler/pipes/register-variables.h"
 #include "compiler/pipes/remove-empty-function-calls.h"
 #include "compiler/pipes/resolve-self-static-parent.h"
+#include "compiler/pipes/reuse-array-literals.h"
 #include "compiler/pipes/sort-and-inherit-classes.h"
 #include "compiler/pipes/split-switch.h"
 #include "compiler/pipes/type-inferer.h"
@@ -223,6 +229,7 @@ bool compiler_execute(CompilerSettings *settings) {
   }
 
   G->try_load_tl_classes();
+  G->try_load_function_profile();
   stage::set_name("Load Composer packages");
   G->init_composer_class_loader();
   stage::die_if_global_errors();
@@ -274,6 +281,7 @@ bool compiler_execute(CompilerSettings *settings) {
     >> PassC<PropagateThrowFlagPass>{}
     >> PassC<CheckModificationsOfConstVars>{}
     >> PipeC<CalcRLF>{}
+    >> PassC<LowerArraysToShapesPass>{}
     >> PipeC<CFGBeginF>{}
     >> SyncC<CFGBeginSync>{}
     >> PassC<CloneStrangeConstParams>{}
@@ -284,11 +292,16 @@ bool compiler_execute(CompilerSettings *settings) {
     >> PassC<CheckClassesPass>{}
     >> PassC<CheckConversionsPass>{}
     >> PassC<OptimizationPass>{}
+    >> PassC<InferListArraysPass>{}
+    >> PassC<DevirtualizeCallsPass>{}
+    >> PassC<HoistPureExpressionsPass>{}
     >> PassC<FixReturnsPass>{}
     >> PassC<CalcValRefPass>{}
     >> PassC<CalcFuncDepPass>{}
     >> SyncC<CalcBadVarsF>{}
     >> PipeC<CheckUBF>{}
+    >> PassC<MoveLastUsagesPass>{}
+    >> PassC<ReuseArrayLiteralsPass>{}
     >> PassC<ExtractResumableCallsPass>{}
     >> PassC<ExtractAsyncPass>{}
     >> PassC<CheckNestedForeachPass>{}
@@ -256,6 +256,7 @@ vk::string_view FunctionData::get_tmp_string_specialization() const {
   static std::unordered_map<vk::string_view, vk::string_view> funcs = {
     {"substr", "_tmp_substr"},
     {"trim", "_tmp_trim"},
+    {"_explode_nth", "_tmp_explode_nth"},
     // TODO: ltrim, rtrim, strstr
   };
   auto it = funcs.find(name);
@@ -133,6 +133,19 @@ public:
 
   int8_t readonly_param_index = -1; // until we need more than one, encode it as a byte-sized index
 
+  // how this function is called from other user functions, used by the inlining cost model (see InlineSimpleFunctions)
+  int call_sites_total = 0;
+  int call_sites_in_loops = 0;
+  int call_sites_with_const_args = 0;
+  int call_sites_recursive = 0;
+
+  // how often this function is called on a running site, according to --function-profile (see FunctionProfile)
+  enum class profile_hotness_t : uint8_t {
+    unknown,
+    hot,
+    cold,
+  } profile_hotness = profile_hotness_t::unknown;
+
   function_palette::ColorContainer colors{};            // colors specified with @kphp-color
   std::vector<FunctionPtr> *next_with_colors{nullptr};  // next colored functions reachable via call graph
 
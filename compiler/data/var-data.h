@@ -40,6 +40,7 @@ public:
   bool optimize_flag = false;
   bool tinf_flag = false;
   bool needs_const_iterator_flag = false;
+  bool is_list_array = false;      // always a vector at runtime, see InferListArraysPass
   bool marked_as_global = false;
   bool marked_as_const = false;
   bool is_read_only = true;
@@ -0,0 +1,96 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#include "compiler/function-profile.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <vector>
+
+#include "common/wrappers/fmt_format.h"
+#include "common/wrappers/string_view.h"
+
+#include "compiler/stage.h"
+
+// functions that make 90% of all calls together are hot, and ones with less than 0.01% of calls are cold
+static constexpr double HOT_CALLS_SHARE = 0.9;
+static constexpr uint64_t COLD_CALLS_DIVISOR = 10000;
+
+// fn=Foo::bar (label) — a label is appended if a function uses profiler_set_function_label()
+static std::string function_name_without_label(vk::string_view name) {
+  if (!name.empty() && name.back() == ')') {
+    const size_t label_pos = name.rfind(" (");
+    if (label_pos != vk::string_view::npos) {
+      name = name.substr(0, label_pos);
+    }
+  }
+  return static_cast<std::string>(name);
+}
+
+void FunctionProfile::load_from(const std::string &callgrind_file) {
+  std::ifstream in(callgrind_file);
+  kphp_error_return(in.is_open(), fmt_format("Can't open profile file {}", callgrind_file));
+
+  // every profiled function has its own fn= block, where the functions called from it are listed as cfn= with calls=
+  std::string line;
+  std::string callee;
+  while (std::getline(in, line)) {
+    vk::string_view line_view{line};
+    if (line_view.starts_with("fn=")) {
+      calls_.emplace(function_name_without_label(line_view.substr(3)), 0);
+    } else if (line_view.starts_with("cfn=")) {
+      callee = function_name_without_label(line_view.substr(4));
+    } else if (line_view.starts_with("calls=") && !callee.empty()) {
+      // calls=<count> <target position>; a malformed count is skipped rather than wrapped around, like strtoull("-1") would do
+      if (line.size() > 6 && std::isdigit(static_cast<unsigned char>(line[6]))) {
+        calls_[callee] += std::strtoull(line.c_str() + 6, nullptr, 10);
+      }
+    }
+  }
+
+  std::vector<uint64_t> sorted_calls;
+  sorted_calls.reserve(calls_.size());
+  uint64_t total_calls = 0;
+  for (const auto &name_and_calls : calls_) {
+    sorted_calls.emplace_back(name_and_calls.second);
+    total_calls += name_and_calls.second;
+  }
+  std::sort(sorted_calls.begin(), sorted_calls.end(), std::greater<>{});
+
+  uint64_t accumulated_calls = 0;
+  hot_calls_threshold_ = total_calls + 1;
+  for (uint64_t calls : sorted_calls) {
+    if (calls == 0 || accumulated_calls >= HOT_CALLS_SHARE * total_calls) {
+      break;
+    }
+    accumulated_calls += calls;
+    hot_calls_threshold_ = calls;
+  }
+  cold_calls_threshold_ = total_calls / COLD_CALLS_DIVISOR;
+}
+
+FunctionData::profile_hotness_t FunctionProfile::get_hotness(const std::string &function_name) const {
+  // a function is absent in a profile if it wasn't reachable from profiled roots (kphp2cpp -g 1), nothing is known about it;
+  // roots themselves have no callers and zero calls, that's why zero calls doesn't mean cold
+  auto it = calls_.find(function_name);
+  if (it == calls_.end() || it->second == 0) {
+    return FunctionData::profile_hotness_t::unknown;
+  }
+  if (it->second >= hot_calls_threshold_) {
+    return FunctionData::profile_hotness_t::hot;
+  }
+  if (it->second < cold_calls_threshold_) {
+    return FunctionData::profile_hotness_t::cold;
+  }
+  return FunctionData::profile_hotness_t::unknown;
+}
+
+void FunctionProfile::apply_to(FunctionPtr function) const {
+  const auto hotness = get_hotness(function->as_human_readable(false));
+  if (hotness != FunctionData::profile_hotness_t::unknown) {
+    function->profile_hotness = hotness;
+  }
+}
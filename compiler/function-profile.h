@@ -0,0 +1,32 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include "compiler/data/data_ptr.h"
+#include "compiler/data/function-data.h"
+
+// a profile of a running site, written by the tracing profiler of the runtime (kphp2cpp -g, see runtime/profiler.cpp);
+// call counts from it are fed back to the compiler: hot functions are inlined more aggressively,
+// placed together into one object and marked __attribute__((hot)), rarely called ones are marked __attribute__((cold))
+class FunctionProfile {
+public:
+  // several callgrind files (from different workers) may be concatenated into one, the call counts are summed up
+  void load_from(const std::string &callgrind_file);
+
+  bool empty() const { return calls_.empty(); }
+
+  // a function is looked up by FunctionData::as_human_readable(false), e.g. Foo::bar
+  FunctionData::profile_hotness_t get_hotness(const std::string &function_name) const;
+  void apply_to(FunctionPtr function) const;
+
+private:
+  std::unordered_map<std::string, uint64_t> calls_;
+  uint64_t hot_calls_threshold_{0};
+  uint64_t cold_calls_threshold_{0};
+};
@@ -278,6 +278,9 @@ void ExprNodeRecalc::recalc_expr(VertexPtr expr) {
     case op_move:
       recalc_expr(expr.as<op_move>()->expr());
       break;
+    case op_array_refill:
+      recalc_expr(expr.as<op_array_refill>()->array());
+      break;
     case op_ternary:
       recalc_ternary(expr.as<op_ternary>());
       break;
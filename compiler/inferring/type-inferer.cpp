@@ -10,6 +10,7 @@
 #include "compiler/inferring/edge.h"
 #include "compiler/inferring/public.h"
 #include "compiler/inferring/restriction-match-phpdoc.h"
+#include "compiler/scheduler/scheduler-base.h"
 #include "compiler/threading/profiler.h"
 
 namespace tinf {
@@ -20,7 +21,7 @@ TypeInferer::TypeInferer()
 void TypeInferer::recalc_node(Node *node) {
   //fprintf (stderr, "tinf::recalc_node %d %p %s\n", get_thread_id(), node, node->get_description().c_str());
   if (node->try_start_recalc()) {
-    Q->push(node);
+    Q->push_back(node);
   }
 }
 
@@ -82,20 +83,40 @@ public:
 
 CachedProfiler TypeInfererTask::type_inferer_profiler{"Type Inferring"};
 
+// a queue is a worklist of nodes in the need_relaunch state; every node is in at most one queue at a time,
+// because only a successful try_start_recalc() pushes it, so the queue may be split at any point between nodes;
+// the nodes reached while processing a queue are pushed to the same queue, which makes a single task
+// grow to the whole call graph on large projects, while other threads are idle —
+// that's why a grown queue is split, and its tail is given to the scheduler as a separate task
+static constexpr size_t max_queue_size_before_split = 4096;
+
 std::vector<Task *> TypeInferer::get_tasks() {
   std::vector<Task *> res;
   for (int i = 0; i < Q.size(); i++) {
-    NodeQueue q = std::move(Q.get(i));
-    if (q.empty()) {
-      continue;
+    NodeQueue &q = Q.get(i);
+    while (q.size() > max_queue_size_before_split) {
+      NodeQueue part(q.end() - max_queue_size_before_split, q.end());
+      q.erase(q.end() - max_queue_size_before_split, q.end());
+      res.push_back(new TypeInfererTask(this, std::move(part)));
+    }
+    if (!q.empty()) {
+      res.push_back(new TypeInfererTask(this, std::move(q)));
+      q.clear();
     }
-
-    res.push_back(new TypeInfererTask(this, std::move(q)));
   }
   return res;
 }
 
-void TypeInferer::do_run_queue() {
+void TypeInferer::split_queue(NodeQueue &q) {
+  // the front node stays: it's the next one to be processed by the current thread
+  auto middle = q.begin() + q.size() / 2;
+  NodeQueue tail(middle, q.end());
+  q.erase(middle, q.end());
+  ++G->stats.cnt_type_inferer_split_tasks;
+  register_async_task(new TypeInfererTask(this, std::move(tail)));
+}
+
+void TypeInferer::do_run_queue(bool allow_split) {
   NodeQueue &q = Q.get();
 
   while (!q.empty()) {
@@ -104,20 +125,24 @@ void TypeInferer::do_run_queue() {
     node->start_recalc();
     node->recalc(this);
     if (node->try_finish_recalc()) {
-      q.pop();
+      q.pop_front();
+      if (allow_split && q.size() > max_queue_size_before_split) {
+        split_queue(q);
+      }
     }
   }
 }
 
 void TypeInferer::run_queue(NodeQueue *new_q) {
   *Q = std::move(*new_q);
-  do_run_queue();
+  // after finish() nodes are inferred lazily by the following passes, there is no one to wait for the split tasks
+  do_run_queue(!finish_flag);
 }
 
 void TypeInferer::run_node(Node *node) {
   if (!node->was_recalc_started_at_least_once()) {
     add_node(node);
-    do_run_queue();
+    do_run_queue(false);
   }
   while (!node->was_recalc_finished_at_least_once()) {
     usleep(250);
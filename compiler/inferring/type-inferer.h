@@ -4,7 +4,7 @@
 
 #pragma once
 
-#include <queue>
+#include <deque>
 
 #include "compiler/inferring/node.h"
 #include "compiler/inferring/restriction-base.h"
@@ -13,7 +13,7 @@
 
 namespace tinf {
 
-using NodeQueue = std::queue<Node *>;
+using NodeQueue = std::deque<Node *>;
 
 class TypeInferer {
 private:
@@ -43,7 +43,8 @@ public:
   bool is_finished() const { return finish_flag; }
 
 private:
-  void do_run_queue();
+  void do_run_queue(bool allow_split);
+  void split_queue(NodeQueue &q);
 };
 
 } // namespace tinf
@@ -273,8 +273,14 @@ int main(int argc, char *argv[]) {
              "archive-creator", "KPHP_ARCHIVE_CREATOR", "ar");
   parser.add("Use dynamic incremental linkage for building the output binary", settings->dynamic_incremental_linkage,
              "dynamic-incremental-linkage", "KPHP_DYNAMIC_INCREMENTAL_LINKAGE");
+  parser.add("Build the output binary with C++ compiler instrumentation, writing branch profiles to the directory", settings->cxx_profile_generate_dir,
+             "cxx-profile-generate", "KPHP_CXX_PROFILE_GENERATE");
+  parser.add("Build the output binary using C++ compiler branch profiles from the directory", settings->cxx_profile_use_dir,
+             "cxx-profile-use", "KPHP_CXX_PROFILE_USE");
   parser.add("Profile functions: 0 - disabled, 1 - enabled for marked functions, 2 - enabled for all", settings->profiler_level,
              'g', "profiler", "KPHP_PROFILER", "0", {"0", "1", "2"});
+  parser.add("Callgrind file written by the profiler (-g), used for inlining and hot/cold functions placement", settings->function_profile_file,
+             "function-profile", "KPHP_FUNCTION_PROFILE");
   parser.add("Enable an ability to get global vars memory stats", settings->enable_global_vars_memory_stats,
              "enable-global-vars-memory-stats", "KPHP_ENABLE_GLOBAL_VARS_MEMORY_STATS");
   parser.add("Enable all inspections available for @kphp-analyze-performance for all reachable functions", settings->enable_full_performance_analyze,
@@ -314,6 +320,7 @@ int main(int argc, char *argv[]) {
   parser.add_implicit_option("Generated runtime path", settings->generated_runtime_path);
   parser.add_implicit_option("Performance report path", settings->performance_analyze_report_path);
   parser.add_implicit_option("C++ compiler toolchain option", settings->cxx_toolchain_option);
+  parser.add_implicit_option("C++ compiler profile guided optimization flags", settings->cxx_pgo_flags);
 
   try {
     parser.process_args(argc, argv);
@@ -630,6 +630,28 @@ class CalcBadVars {
     }
   };
 
+  static void calc_call_sites(const std::vector<DepData> &dep_datas) {
+    for (const auto &data : dep_datas) {
+      for (const auto &call_site : data.call_sites) {
+        FunctionPtr callee = call_site.callee;
+        callee->call_sites_total++;
+        callee->call_sites_in_loops += call_site.in_loop;
+        callee->call_sites_with_const_args += call_site.with_const_args;
+        callee->call_sites_recursive += call_site.is_recursive;
+      }
+    }
+  }
+
+  static void apply_function_profile(const std::vector<FunctionPtr> &functions) {
+    const FunctionProfile &profile = G->get_function_profile();
+    if (profile.empty()) {
+      return;
+    }
+    for (FunctionPtr function : functions) {
+      profile.apply_to(function);
+    }
+  }
+
   void generate_ref_vars(const std::vector<DepData> &dep_datas) {
     std::vector<VarPtr> vars;
     for (const auto &data : dep_datas) {
@@ -665,6 +687,7 @@ public:
       functions[i] = tmp_vec[i].first;
       dep_datas[i] = std::move(tmp_vec[i].second);
     }
+    apply_function_profile(functions);
 
     {
       FuncCallGraph call_graph(std::move(functions), dep_datas);
@@ -675,6 +698,7 @@ public:
     }
 
     generate_ref_vars(dep_datas);
+    calc_call_sites(dep_datas);
   }
 };
 
@@ -4,6 +4,7 @@
 
 #include "compiler/pipes/calc-const-types.h"
 
+#include "compiler/compile-time-eval.h"
 #include "compiler/data/class-data.h"
 #include "compiler/data/src-file.h"
 #include "compiler/data/var-data.h"
@@ -41,6 +42,12 @@ VertexPtr CalcConstTypePass::on_exit_vertex(VertexPtr v) {
   // for now only pure functions and
   // constructors in defines can be `cnst_const_val`-ed
   if (auto as_func_call = v.try_as<op_func_call>()) {
+    const bool has_const_args = vk::all_of(*v, [](VertexPtr son) { return son->const_type == cnst_const_val; });
+    if (has_const_args) {
+      if (VertexPtr evaluated = try_eval_builtin_call(as_func_call)) {
+        return evaluated;
+      }
+    }
     const bool can_be_const = as_func_call->func_id && ((as_func_call->func_id->is_constructor() && inlined_define_cnt > 0)|| as_func_call->func_id->is_pure);
     if (!can_be_const) {
       v->const_type = cnst_nonconst_val;
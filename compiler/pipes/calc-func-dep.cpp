@@ -9,6 +9,21 @@
 #include "compiler/inferring/public.h"
 #include "compiler/vertex.h"
 
+static bool is_const_arg(VertexPtr arg) {
+  switch (arg->type()) {
+    case op_int_const:
+    case op_float_const:
+    case op_true:
+    case op_false:
+    case op_null:
+      return true;
+    case op_var:
+      return arg->extra_type == op_ex_var_const;
+    default:
+      return false;
+  }
+}
+
 VertexPtr CalcFuncDepPass::on_enter_vertex(VertexPtr vertex) {
   if (!calls.empty() && calls.back()->is_extern() && vertex->type() == op_callback_of_builtin) {
     FunctionPtr callback_passed_to_extern_func = vertex.as<op_callback_of_builtin>()->func_id;
@@ -31,6 +46,10 @@ VertexPtr CalcFuncDepPass::on_enter_vertex(VertexPtr vertex) {
     //}
   }
 
+  if (vertex.try_as<meta_op_cycle>()) {
+    ++loops_depth;
+  }
+
   if (auto instanceof = vertex.try_as<op_instanceof>()) {
     current_function->class_dep.insert(instanceof->derived_class);
   }
@@ -75,6 +94,9 @@ VertexPtr CalcFuncDepPass::on_enter_vertex(VertexPtr vertex) {
       return vertex;
     }
 
+    const bool with_const_args = !call->args().empty() && std::all_of(call->args().begin(), call->args().end(), is_const_arg);
+    data.call_sites.emplace_back(CallSiteData{other_function, loops_depth > 0, with_const_args, other_function == current_function});
+
     int cnt_func_params = other_function->param_ids.size();
     if(other_function->has_variadic_param) {
       cnt_func_params--;
@@ -120,6 +142,8 @@ VertexPtr CalcFuncDepPass::on_enter_vertex(VertexPtr vertex) {
 VertexPtr CalcFuncDepPass::on_exit_vertex(VertexPtr vertex) {
   if (vertex->type() == op_func_call) {
     calls.pop_back();
+  } else if (vertex.try_as<meta_op_cycle>()) {
+    --loops_depth;
   }
 
   return vertex;
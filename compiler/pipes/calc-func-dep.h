@@ -11,6 +11,13 @@
 
 #include "compiler/function-pass.h"
 
+struct CallSiteData {
+  FunctionPtr callee;
+  bool in_loop;
+  bool with_const_args;
+  bool is_recursive;
+};
+
 struct DepData : private vk::movable_only {
   std::vector<FunctionPtr> dep;               // functions accessible directly from the current (called or lambdas) (except extern)
   std::vector<VarPtr> modified_global_vars;   // val_l globals for ub check later
@@ -20,6 +27,8 @@ struct DepData : private vk::movable_only {
   std::forward_list<std::pair<VarPtr, VarPtr>> global_ref_edges;  // calls to f($v) when $v is a global
 
   std::forward_list<FunctionPtr> forks;       // calls to fork(f(...)) to calc resumable graph later
+
+  std::vector<CallSiteData> call_sites;       // all calls of non-extern functions (not unique), for the inlining cost model
 };
 
 static_assert(std::is_nothrow_move_constructible<DepData>::value, "DepData should be movable");
@@ -29,6 +38,7 @@ class CalcFuncDepPass final : public FunctionPassBase {
 private:
   DepData data;
   std::vector<FunctionPtr> calls;
+  int loops_depth{0};
 public:
 
   std::string get_description() override {
@@ -188,6 +188,11 @@ std::string CodeGenF::calc_subdir_for_function(FunctionPtr func) {
     return "o_l";
   }
 
+  // hot functions are linked together into one object, so that they are close to each other in the binary
+  if (func->profile_hotness == FunctionData::profile_hotness_t::hot) {
+    return "o_hot";
+  }
+
   int bucket = vk::std_hash(func->file_id->short_file_name) % 100;
   return "o_" + std::to_string(bucket);
 }
@@ -4,9 +4,11 @@
 
 #include "compiler/pipes/convert-sprintf-calls.h"
 
-#include "compiler/vertex-util.h"
+#include <algorithm>
 #include <utility>
 
+#include "compiler/vertex-util.h"
+
 struct FormatCallInfo {
   FormatCallInfo() : args(VertexRange(Vertex::iterator{}, Vertex::iterator{})) {}
   // stores a variable that contains all the call arguments,
@@ -22,51 +24,121 @@ struct FormatCallInfo {
 };
 
 struct FormatPart {
-  enum class FormatSpecType {
-    decimal,
-    string
-  };
-
   explicit FormatPart(std::string value)
     : value(std::move(value)) {}
 
-  explicit FormatPart(FormatSpecType specifier)
-    : specifier(specifier) {}
+  explicit FormatPart(char conversion)
+    : conversion(conversion) {}
 
+  // a literal text, empty for conversion specifications
   std::string value;
-  FormatSpecType specifier{};
+
+  // a conversion specification: %[argnum$][+][0| |'char][-][width][.precision]conversion,
+  // parsed exactly like f$sprintf() does it in runtime
+  char conversion{0};
+  size_t arg_index{0};
+  bool plus_sign{false};
+  char filler{' '};
+  bool pad_right{false};
+  int64_t width{0};
+  int64_t precision{-1};
 
   bool is_specifier() const {
-    return value.empty();
+    return conversion != 0;
+  }
+
+  // %d and %s without any modifiers are just casts
+  bool is_plain_cast() const {
+    return !plus_sign && width == 0 && precision == -1 && vk::any_of_equal(conversion, 'd', 's');
   }
 };
 
+// huge widths and precisions are left for the runtime sprintf() with its checks
+static constexpr int64_t MAX_COMPILED_WIDTH = 1 << 16;
+
+static int64_t parse_format_number(const std::string &format, size_t &i) {
+  int64_t number = 0;
+  while (i < format.size() && '0' <= format[i] && format[i] <= '9' && number <= MAX_COMPILED_WIDTH) {
+    number = number * 10 + format[i++] - '0';
+  }
+  return number;
+}
+
+// returns an empty vector if the format can't be compiled, then sprintf() is left as is
 std::vector<FormatPart> try_parse_format_string(const std::string &format) {
   std::vector<FormatPart> parts;
   std::string last_value;
-  bool find_percent = false;
-
-  for (const auto &symbol : format) {
-    if (find_percent) {
-      if (symbol == 'd') {
-        parts.emplace_back(FormatPart::FormatSpecType::decimal);
-      } else if (symbol == 's') {
-        parts.emplace_back(FormatPart::FormatSpecType::string);
-      } else if (symbol == '%') {
-        last_value += "%";
-      } else {
+  size_t next_arg_index = 0;
+
+  for (size_t i = 0; i < format.size(); i++) {
+    if (format[i] != '%') {
+      last_value += format[i];
+      continue;
+    }
+    i++;
+
+    FormatPart spec{'\0'};
+    bool has_arg_num = false;
+    size_t j = i;
+    const int64_t arg_num = parse_format_number(format, j);
+    if (j < format.size() && format[j] == '$') {
+      if (arg_num == 0 || arg_num > MAX_COMPILED_WIDTH) {
         return {};
       }
-      find_percent = false;
-    } else if (symbol == '%') {
-      find_percent = true;
-      if (!last_value.empty()) {
-        parts.emplace_back(std::move(last_value));
-        last_value = "";
+      has_arg_num = true;
+      spec.arg_index = arg_num - 1;
+      i = j + 1;
+    }
+    if (i < format.size() && format[i] == '+') {
+      spec.plus_sign = true;
+      i++;
+    }
+    if (i < format.size() && (format[i] == '0' || format[i] == ' ')) {
+      spec.filler = format[i++];
+    } else if (i + 1 < format.size() && format[i] == '\'') {
+      spec.filler = format[i + 1];
+      i += 2;
+    }
+    if (i < format.size() && format[i] == '-') {
+      spec.pad_right = true;
+      i++;
+    }
+    spec.width = parse_format_number(format, i);
+    if (i + 1 < format.size() && format[i] == '.' && '0' <= format[i + 1] && format[i + 1] <= '9') {
+      i++;
+      spec.precision = parse_format_number(format, i);
+    }
+    if (i >= format.size() || spec.width >= MAX_COMPILED_WIDTH || spec.precision >= MAX_COMPILED_WIDTH) {
+      return {};
+    }
+
+    if (format[i] == '%') {
+      // even %% is padded by runtime
+      std::string percent{"%"};
+      if (spec.width > 1) {
+        percent.insert(spec.pad_right ? 1 : 0, spec.width - 1, spec.filler);
       }
-    } else {
-      last_value += symbol;
+      last_value += percent;
+      continue;
+    }
+    if (!vk::any_of_equal(format[i], 'b', 'd', 'u', 'o', 'x', 'X', 'e', 'E', 'f', 'F', 'g', 'G', 's')) {
+      return {}; // %c with its range warnings and invalid specifiers
+    }
+    spec.conversion = format[i];
+    // f$sprintf() prints strings by snprintf() into a limited buffer, cutting them at '\0' and failing on huge ones;
+    // only a precision bounds the printed length, so the compiled %s with modifiers requires it
+    if (spec.conversion == 's' && !spec.is_plain_cast() && spec.precision < 0) {
+      return {};
+    }
+    if (!has_arg_num) {
+      spec.arg_index = next_arg_index++;
     }
+
+    if (!last_value.empty()) {
+      parts.emplace_back(std::move(last_value));
+      last_value = "";
+    }
+    parts.emplace_back(std::move(spec));
   }
 
   if (!last_value.empty()) {
@@ -76,6 +148,11 @@ std::vector<FormatPart> try_parse_format_string(const std::string &format) {
   return parts;
 }
 
+// an argument that can be dropped without being evaluated
+static bool is_side_effect_free(VertexPtr arg) {
+  return vk::any_of_equal(VertexUtil::get_actual_value(arg)->type(), op_var, op_int_const, op_float_const, op_string, op_true, op_false, op_null);
+}
+
 VertexPtr ConvertSprintfCallsPass::on_exit_vertex(VertexPtr root) {
   if (auto func_call = root.try_as<op_func_call>()) {
     const auto func = func_call->func_id;
@@ -100,14 +177,23 @@ VertexPtr ConvertSprintfCallsPass::convert_sprintf_call(VertexAdaptor<op_func_ca
     return call;
   }
 
-  const auto count_specifiers = std::count_if(parts.begin(), parts.end(), [](const FormatPart &part) {
-    return part.is_specifier();
-  });
+  // the arguments are in order, if the specifiers use each of them once: the 1st, the 2nd, etc.
+  size_t count_args = 0;
+  bool args_in_order = true;
+  for (const auto &part : parts) {
+    if (part.is_specifier()) {
+      args_in_order &= part.arg_index == count_args;
+      count_args = std::max(count_args, part.arg_index + 1);
+    }
+  }
 
   FormatCallInfo info;
 
-  // if sprintf call with args
-  if (args.size() > 1) {
+  if (count_args > 0 && args.size() < 2) {
+    return call;
+  }
+  // the arguments are checked even if none of them is used, they may have side effects
+  if (args.size() >= 2) {
     const auto format_args_raw = args[1];
     switch (format_args_raw->type()) {
       // if all arguments are constant
@@ -131,56 +217,97 @@ VertexPtr ConvertSprintfCallsPass::convert_sprintf_call(VertexAdaptor<op_func_ca
         return call;
     }
 
-    if (count_specifiers > info.args.size()) {
+    if (count_args > info.args.size()) {
+      return call;
+    }
+    // argnum$ may reorder or repeat only the arguments without side effects,
+    // and the unused arguments are dropped, so they mustn't have them either
+    const auto first_unused_arg = args_in_order ? std::next(info.args.begin(), count_args) : info.args.begin();
+    if (!info.is_var && !std::all_of(first_unused_arg, info.args.end(), is_side_effect_free)) {
       return call;
     }
   }
 
   std::vector<VertexPtr> vertex_parts;
-  size_t index_spec = 0;
-
+  vertex_parts.reserve(parts.size());
   for (const auto &part : parts) {
-    const auto vertex = convert_format_part_to_vertex(part, index_spec, info);
-    vertex_parts.push_back(vertex);
-
-    if (part.is_specifier()) {
-      index_spec++;
-    }
+    vertex_parts.push_back(convert_format_part_to_vertex(part, info));
   }
 
   return VertexAdaptor<op_string_build>::create(vertex_parts);
 }
 
-VertexPtr ConvertSprintfCallsPass::convert_format_part_to_vertex(const FormatPart &part, size_t arg_index, const FormatCallInfo &info) {
-  if (part.is_specifier()) {
-    VertexPtr element;
+VertexPtr ConvertSprintfCallsPass::convert_format_part_to_vertex(const FormatPart &part, const FormatCallInfo &info) {
+  if (!part.is_specifier()) {
+    return VertexUtil::create_string_const(part.value);
+  }
 
-    if (info.is_var) {
-      // building $arr[$index]
-      auto index_vertex = VertexAdaptor<op_int_const>::create();
-      index_vertex->set_string(std::to_string(arg_index));
-      element = VertexAdaptor<op_index>::create(info.var, index_vertex);
-    } else {
-      element = info.args[arg_index];
-    }
+  VertexPtr element;
+  if (info.is_var) {
+    // building $arr[$index]
+    element = VertexAdaptor<op_index>::create(info.var, VertexUtil::create_int_const(part.arg_index));
+  } else {
+    element = info.args[part.arg_index];
+  }
 
+  if (part.is_plain_cast()) {
     VertexPtr convert;
+    if (part.conversion == 'd') {
+      convert = VertexAdaptor<op_conv_int>::create(element);
+    } else {
+      convert = VertexAdaptor<op_conv_string>::create(element);
+    }
+    return VertexAdaptor<op_conv_string>::create(convert);
+  }
 
-    switch (part.specifier) {
-      case FormatPart::FormatSpecType::decimal:
-        convert = VertexAdaptor<op_conv_int>::create(element);
-        break;
-      case FormatPart::FormatSpecType::string:
-        convert = VertexAdaptor<op_conv_string>::create(element);
-        break;
-      default:
-        return element;
+  // other specifiers are formatted by the typed runtime functions, see _sprintf_* in kphp_internal.txt;
+  // everything that f$sprintf() parses is passed as constants
+  auto create_bool_const = [](bool value) -> VertexPtr {
+    if (value) {
+      return VertexAdaptor<op_true>::create();
     }
+    return VertexAdaptor<op_false>::create();
+  };
+  const auto filler = VertexUtil::create_int_const(static_cast<unsigned char>(part.filler));
+  const auto width = VertexUtil::create_int_const(part.width);
 
-    return VertexAdaptor<op_conv_string>::create(convert);
+  std::vector<VertexPtr> call_args;
+  std::string func_name;
+  switch (part.conversion) {
+    case 'e':
+    case 'E':
+    case 'f':
+    case 'F':
+    case 'g':
+    case 'G': {
+      std::string c_format{"%"};
+      if (part.plus_sign) {
+        c_format += '+';
+      }
+      if (part.precision >= 0) {
+        c_format += "." + std::to_string(part.precision);
+      }
+      c_format += part.conversion;
+      func_name = "_sprintf_float";
+      call_args = {VertexAdaptor<op_conv_float>::create(element), VertexUtil::create_string_const(c_format), width, filler,
+                   create_bool_const(part.pad_right)};
+      break;
+    }
+    case 's':
+      func_name = "_sprintf_string";
+      call_args = {VertexAdaptor<op_conv_string>::create(element), VertexUtil::create_int_const(part.precision), width, filler,
+                   create_bool_const(part.pad_right)};
+      break;
+    default:
+      func_name = "_sprintf_int";
+      call_args = {VertexAdaptor<op_conv_int>::create(element), VertexUtil::create_int_const(part.conversion), width, filler,
+                   create_bool_const(part.pad_right), create_bool_const(part.plus_sign)};
+      break;
   }
 
-  VertexAdaptor<op_string> vertex = VertexAdaptor<op_string>::create();
-  vertex->set_string(part.value);
-  return vertex;
+  auto format_call = VertexAdaptor<op_func_call>::create(call_args);
+  format_call->set_string(func_name);
+  format_call->func_id = G->get_function(func_name);
+  format_call->auto_inserted = true;
+  return format_call;
 }
@@ -12,13 +12,15 @@ struct FormatPart;
 
 // This pipe rewrites some sprintf calls.
 //
-// If the format string contains only simple specifiers %s and %d,
-// then such a call is replaced with concatenation.
+// If the format string is a constant, then such a call is replaced with concatenation:
+// simple specifiers %s and %d become casts, and the specifiers with modifiers
+// (width, padding, precision, %f, %x, etc.) become calls of typed _sprintf_* functions,
+// so neither the format is parsed nor the arguments are packed into array<mixed> in runtime.
 //
 // For example:
-//   echo sprintf("Hello %s", $name);
+//   echo sprintf("Hello %s, you have %05.2f", $name, $balance);
 // converted to:
-//   echo "Hello " . $name;
+//   echo "Hello " . $name . ", you have " . _sprintf_float($balance, "%.2f", 5, ord('0'), false);
 //
 // Depending on the length of the string and count specifiers, the speed
 // of concatenation is several times faster. Even for the given example,
@@ -37,5 +39,5 @@ public:
 
 private:
   static VertexPtr convert_sprintf_call(VertexAdaptor<op_func_call> call);
-  static VertexPtr convert_format_part_to_vertex(const FormatPart &part, size_t arg_index, const FormatCallInfo &info);
+  static VertexPtr convert_format_part_to_vertex(const FormatPart &part, const FormatCallInfo &info);
 };
@@ -0,0 +1,136 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#include "compiler/pipes/devirtualize-calls.h"
+
+#include "compiler/compiler-core.h"
+#include "compiler/data/class-data.h"
+#include "compiler/data/src-file.h"
+#include "compiler/data/var-data.h"
+#include "compiler/inferring/public.h"
+
+// a call $obj->f() of a virtual method f() is compiled into a call of a generated dispatcher,
+// which switches on $obj->get_hash() (see generate-virtual-methods.cpp)
+// but after type inferring we often know, that $obj is a concrete class without inheritors,
+// or that all inheritors of $obj's class share the same f() implementation;
+// in that case the dispatcher is bypassed, and the implementation is called directly:
+//
+// class Base { function f() {...} }  class Other extends Base { function f() {...} }  class Leaf extends Base {}
+// $leaf = new Leaf; $leaf->f();    // Base::f() is virtual, but for Leaf it's always Base::f_self$()
+//
+// note, that the implementation must be owned by the receiver class or its ancestor, so that no downcast is needed
+//
+// the dispatcher also raises "call method on null object" for a null receiver (its default case);
+// a direct call keeps that check by remembering the virtual function in devirtualized_from,
+// codegen wraps the receiver then (except $this and new-expressions, which are never null)
+
+FunctionPtr DevirtualizeCallsPass::find_single_implementation(ClassPtr receiver_class, FunctionPtr virtual_function) {
+  std::vector<ClassPtr> possible_classes = receiver_class->get_all_derived_classes();
+  possible_classes.emplace_back(receiver_class);
+
+  FunctionPtr implementation;
+  for (ClassPtr klass : possible_classes) {
+    if (!klass->is_class() || klass->modifiers.is_abstract()) {
+      continue;
+    }
+    const auto *method = klass->get_instance_method(virtual_function->local_name());
+    if (!method) {
+      return {};
+    }
+    FunctionPtr concrete = method->function;
+    if (concrete->is_virtual_method) {
+      if (concrete->file_id->is_builtin()) {
+        return {};
+      }
+      const auto *self_method = concrete->class_id->members.get_instance_method(concrete->get_name_of_self_method());
+      if (!self_method) {
+        return {};
+      }
+      concrete = self_method->function;
+    }
+    if (implementation && implementation != concrete) {
+      return {};
+    }
+    implementation = concrete;
+  }
+
+  if (!implementation || !implementation->class_id->is_parent_of(receiver_class)) {
+    return {};
+  }
+  return implementation;
+}
+
+// the call site was inferred and compiled against the dispatcher signature;
+// a direct call is safe only if the implementation has exactly the same one
+bool DevirtualizeCallsPass::can_replace_call(FunctionPtr virtual_function, FunctionPtr implementation) {
+  if (implementation->is_extern() || implementation->modifiers.is_abstract() ||
+      implementation->has_variadic_param || virtual_function->has_variadic_param ||
+      implementation->is_resumable != virtual_function->is_resumable) {
+    return false;
+  }
+
+  const auto &virtual_params = virtual_function->param_ids;
+  const auto &implementation_params = implementation->param_ids;
+  if (virtual_params.size() != implementation_params.size()) {
+    return false;
+  }
+  // the first param is $this, its class differs, but class_instance<Derived> is converted to class_instance<Base> implicitly
+  for (size_t i = 1; i < virtual_params.size(); ++i) {
+    if (virtual_params[i]->is_reference != implementation_params[i]->is_reference ||
+        !are_equal_types(tinf::get_type(virtual_params[i]), tinf::get_type(implementation_params[i]))) {
+      return false;
+    }
+  }
+  return are_equal_types(tinf::get_type(virtual_function, -1), tinf::get_type(implementation, -1));
+}
+
+bool DevirtualizeCallsPass::is_receiver_non_null(VertexPtr receiver) {
+  if (receiver->type() == op_alloc) {
+    return true;
+  }
+  if (auto as_call = receiver.try_as<op_func_call>()) {
+    return as_call->func_id && as_call->func_id->is_constructor();
+  }
+  auto as_var = receiver.try_as<op_var>();
+  return as_var && as_var->var_id && as_var->var_id->type() == VarData::var_param_t && as_var->var_id->name == "this";
+}
+
+bool DevirtualizeCallsPass::check_function(FunctionPtr function) const {
+  return !function->is_extern();
+}
+
+VertexPtr DevirtualizeCallsPass::on_enter_vertex(VertexPtr root) {
+  auto call = root.try_as<op_func_call>();
+  if (!call || call->extra_type != op_ex_func_call_arrow || call->args().empty()) {
+    return root;
+  }
+
+  FunctionPtr virtual_function = call->func_id;
+  if (!virtual_function || !virtual_function->is_virtual_method || virtual_function->is_constructor()) {
+    return root;
+  }
+
+  // lca of several classes (after smart casts, for example) is not a single receiver class
+  const TypeData *receiver_type = tinf::get_type(call->args()[0]);
+  ClassPtr receiver_class = receiver_type->ptype() == tp_Class ? receiver_type->class_type() : ClassPtr{};
+  if (!receiver_class || std::next(receiver_type->class_types().begin()) != receiver_type->class_types().end()) {
+    return root;
+  }
+  if (!virtual_function->class_id->is_parent_of(receiver_class)) {
+    return root;
+  }
+
+  FunctionPtr implementation = find_single_implementation(receiver_class, virtual_function);
+  if (!implementation || !can_replace_call(virtual_function, implementation)) {
+    return root;
+  }
+
+  if (!is_receiver_non_null(call->args()[0])) {
+    call->devirtualized_from = virtual_function;
+  }
+  call->func_id = implementation;
+  call->str_val = std::string{implementation->local_name()};
+  ++G->stats.cnt_devirtualized_calls;
+  return root;
+}
@@ -0,0 +1,24 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#pragma once
+
+#include "compiler/function-pass.h"
+
+// replaces calls of virtual methods with direct calls when the inferred receiver class
+// (together with all its inheritors) can reach only one concrete implementation
+class DevirtualizeCallsPass final : public FunctionPassBase {
+  static FunctionPtr find_single_implementation(ClassPtr receiver_class, FunctionPtr virtual_function);
+  static bool can_replace_call(FunctionPtr virtual_function, FunctionPtr implementation);
+  static bool is_receiver_non_null(VertexPtr receiver);
+
+public:
+  std::string get_description() override {
+    return "Devirtualize calls";
+  }
+
+  bool check_function(FunctionPtr function) const override;
+
+  VertexPtr on_enter_vertex(VertexPtr root) override;
+};
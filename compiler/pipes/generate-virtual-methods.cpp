@@ -271,7 +271,7 @@ VertexAdaptor<op_case> gen_case_on_hash(ClassPtr derived, VertexAdaptor<op_seq>
   return VertexAdaptor<op_case>::create(hash_of_derived, cmd);
 }
 
-VertexAdaptor<op_case> gen_case_calling_methods_on_derived_class(ClassPtr derived, FunctionPtr virtual_function) {
+FunctionPtr find_concrete_method_of_derived_class(ClassPtr derived, FunctionPtr virtual_function) {
   FunctionPtr concrete_method_of_derived;
   if (const auto *method_of_derived = derived->members.get_instance_method(virtual_function->local_name())) {
     concrete_method_of_derived = method_of_derived->function;
@@ -297,16 +297,30 @@ VertexAdaptor<op_case> gen_case_calling_methods_on_derived_class(ClassPtr derive
     concrete_method_of_derived = members_of_derived_class.get_instance_method(virtual_function->get_name_of_self_method())->function;
   }
 
-  if (!check_that_signatures_are_same(concrete_method_of_derived->class_id, virtual_function)) {
+  return concrete_method_of_derived;
+}
+
+// all derived classes that share the same implementation are dispatched by one case body:
+// case hash(Derived1): case hash(Derived2): return instance_cast<Owner>($this)->f(...);
+// where Owner is a class the implementation belongs to (a common ancestor of all of them);
+// it keeps switches small for wide hierarchies, where most of the classes don't override a method
+std::vector<VertexPtr> gen_cases_calling_methods_on_derived_classes(const std::vector<ClassPtr> &derived_classes, FunctionPtr concrete_method, FunctionPtr virtual_function) {
+  if (!check_that_signatures_are_same(concrete_method->class_id, virtual_function)) {
     return {};
   }
 
-  VertexPtr this_var = generate_instance_cast_to_call(ClassData::gen_vertex_this({}), derived);
+  ClassPtr cast_to_class = derived_classes.size() == 1 ? derived_classes.front() : concrete_method->class_id;
+  VertexPtr this_var = generate_instance_cast_to_call(ClassData::gen_vertex_this({}), cast_to_class);
   // generate concrete_method call, with arguments from virtual_functions, because of Derived can have extra default params:
-  auto call_self_method_of_derived = generate_call_of_self_method(this_var, virtual_function, concrete_method_of_derived);
+  auto call_self_method_of_derived = generate_call_of_self_method(this_var, virtual_function, concrete_method);
   auto call_derived_method = VertexAdaptor<op_seq>::create(VertexAdaptor<op_return>::create(call_self_method_of_derived));
 
-  return gen_case_on_hash(derived, call_derived_method);
+  std::vector<VertexPtr> cases;
+  for (auto derived = derived_classes.begin(); std::next(derived) != derived_classes.end(); ++derived) {
+    cases.emplace_back(gen_case_on_hash(*derived, VertexAdaptor<op_seq>::create()));
+  }
+  cases.emplace_back(gen_case_on_hash(derived_classes.back(), call_derived_method));
+  return cases;
 }
 
 // we can't express "return default of ReturnT", something like 'return {}' in C++ code
@@ -390,8 +404,9 @@ VertexAdaptor<op_seq> generate_body_of_empty_virtual_method(ClassPtr klass, Func
  *     $tmp->virtual_function($param1, ...);
  *     break;
  *   }
- *   case 0x02280228: { // hash of Derived2
- *     $tmp = instance_cast<Derived2>($this);
+ *   case 0x02280228:   // hash of Derived2, it doesn't override virtual_function()
+ *   case 0x13371337: { // hash of Derived3, it doesn't override virtual_function() also
+ *     $tmp = instance_cast<Base>($this);
  *     $tmp->virtual_function($param1, ...);
  *     break;
  *   }
@@ -409,19 +424,32 @@ void generate_body_of_virtual_method(FunctionPtr virtual_function) {
     kphp_assert(virtual_function->root->cmd()->empty());
   }
 
-  std::vector<VertexPtr> cases;
   std::vector<ClassPtr> all_derived_classes = klass->get_all_derived_classes();
   std::sort(all_derived_classes.begin(), all_derived_classes.end());
   ClassPtr prev_derived;
 
+  // group derived classes by their implementation, keeping the order of the first occurrence
+  std::vector<std::pair<FunctionPtr, std::vector<ClassPtr>>> derived_by_implementation;
   for (ClassPtr derived : all_derived_classes) {
     kphp_error (prev_derived != derived, fmt_format("Duplicated class {} in hierarchy from class {}.\nDiamond inheritance is not supported", derived->name, klass->name));
     prev_derived = derived;
 
-    if (auto v_case = gen_case_calling_methods_on_derived_class(derived, virtual_function)) {
-      cases.emplace_back(v_case);
+    if (FunctionPtr concrete_method = find_concrete_method_of_derived_class(derived, virtual_function)) {
+      auto same_implementation = std::find_if(derived_by_implementation.begin(), derived_by_implementation.end(),
+                                              [concrete_method](const auto &group) { return group.first == concrete_method; });
+      if (same_implementation == derived_by_implementation.end()) {
+        derived_by_implementation.emplace_back(concrete_method, std::vector<ClassPtr>{derived});
+      } else {
+        same_implementation->second.emplace_back(derived);
+      }
     }
   }
+
+  std::vector<VertexPtr> cases;
+  for (const auto &group : derived_by_implementation) {
+    auto group_cases = gen_cases_calling_methods_on_derived_classes(group.second, group.first, virtual_function);
+    cases.insert(cases.end(), group_cases.begin(), group_cases.end());
+  }
   if (!cases.empty()) {
     auto case_default_warn = generate_critical_error_call(fmt_format("call method({}) on null object", virtual_function->as_human_readable()));
     cases.emplace_back(VertexAdaptor<op_default>::create(VertexAdaptor<op_seq>::create(case_default_warn)));
@@ -0,0 +1,456 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#include "compiler/pipes/hoist-pure-expressions.h"
+
+#include "compiler/compiler-core.h"
+#include "compiler/data/var-data.h"
+#include "compiler/inferring/public.h"
+#include "compiler/name-gen.h"
+
+// an expression is pure here, if it's built from local vars, instance props, array reads,
+// pure operators and @kphp-pure-function builtins (see builtin-functions/_functions.txt)
+//
+// 1) a pure expression is invariant in a loop, if none of its vars is written inside the loop
+//    (and for instance props — if the loop doesn't write props and calls only pure functions);
+//    it's computed once before the loop:
+//
+//    for ($i = 0; $i < count($arr); ++$i)          =>  $h = count($arr); for ($i = 0; $i < $h; ++$i)
+//    foreach ($rows as $r) { $s = $p . $q . $r; }  =>  $h = $p . $q; foreach ($rows as $r) { $s = $h . $r; }
+//
+//    a loop body (and a condition of a do-while) may be not executed at all, that's why only expressions,
+//    that can't emit a warning, are hoisted from there: count() of an array, concatenation of scalars;
+//    a loop condition is always evaluated at least once, so any invariant pure expression is hoisted from it
+//
+// 2) a pure expression, that is repeated in a statement without side effects, is computed once before the statement:
+//
+//    $x = $this->data['key'] . ':' . $this->data['key'];   =>  $h = $this->data['key']; $x = $h . ':' . $h;
+//
+// expressions under && || ?? ?: are evaluated conditionally, they are reused only if they are also evaluated unconditionally;
+// an array read checked by isset() / empty() / ?? is never replaced, the check needs the key, not the value
+
+namespace {
+
+bool is_pure_operation(VertexPtr v) {
+  return vk::any_of_equal(v->type(), op_minus, op_plus, op_not, op_log_not,
+                          op_add, op_mul, op_sub, op_div, op_mod, op_pow,
+                          op_and, op_or, op_xor, op_shl, op_shr,
+                          op_log_xor_let, op_log_and_let, op_log_or_let, op_log_and, op_log_or,
+                          op_eq2, op_eq3, op_le, op_lt,
+                          op_spaceship, op_null_coalesce, op_ternary, op_string_build, op_concat);
+}
+
+bool is_conv_operation(VertexPtr v) {
+  return OpInfo::type(v->type()) == conv_op && v->type() != op_move;
+}
+
+bool is_constant(VertexPtr v) {
+  return vk::any_of_equal(v->type(), op_int_const, op_float_const, op_string, op_true, op_false, op_null);
+}
+
+bool is_conditional_child(VertexPtr parent, int child_index) {
+  switch (parent->type()) {
+    case op_log_and:
+    case op_log_or:
+    case op_log_and_let:
+    case op_log_or_let:
+    case op_null_coalesce:
+    case op_ternary:
+      return child_index > 0;
+    default:
+      return false;
+  }
+}
+
+// isset($a['k']), empty($a['k']), unset($a['k']) and $a['k'] ?? $default check whether the key exists,
+// that's why such an op_index must stay in place: a hoisted value has already lost this information
+bool is_key_existence_check(VertexPtr parent, int child_index) {
+  if (vk::any_of_equal(parent->type(), op_isset, op_empty, op_unset)) {
+    return true;
+  }
+  return parent->type() == op_null_coalesce && child_index == 0 && parent.as<op_null_coalesce>()->lhs()->type() == op_index;
+}
+
+bool is_readonly_local(VarPtr var) {
+  return var && vk::any_of_equal(var->type(), VarData::var_local_t, VarData::var_param_t) && !var->is_reference && !var->is_foreach_reference;
+}
+
+bool is_pure_call(VertexAdaptor<op_func_call> call) {
+  FunctionPtr function = call->func_id;
+  return function && function->is_pure && function->is_extern() &&
+         !vk::any_of(function->param_ids, [](VarPtr param) { return param->is_reference; });
+}
+
+bool is_readonly_index(VertexAdaptor<op_index> index) {
+  // ArrayAccess::offsetGet() is an arbitrary user code
+  return index->has_key() && index->rl_type == val_r && tinf::get_type(index->array())->ptype() != tp_Class;
+}
+
+bool is_expensive(VertexPtr v) {
+  return vk::any_of_equal(v->type(), op_index, op_func_call, op_string_build, op_concat);
+}
+
+bool is_silently_converted(const TypeData *type) {
+  return vk::any_of_equal(type->ptype(), tp_string, tp_int, tp_float, tp_bool) && !type->use_optional();
+}
+
+// whether an expression (already known to be pure) may be evaluated speculatively, even if the original code wouldn't
+bool cannot_fail(VertexPtr v) {
+  if (is_constant(v) || v->type() == op_var) {
+    return true;
+  }
+  if (auto prop = v.try_as<op_instance_prop>()) {
+    return prop->instance()->type() == op_var && prop->instance()->extra_type == op_ex_var_this;
+  }
+  if (vk::any_of_equal(v->type(), op_string_build, op_concat)) {
+    return vk::all_of(*v, [](VertexPtr arg) { return is_silently_converted(tinf::get_type(arg)) && cannot_fail(arg); });
+  }
+  if (is_conv_operation(v)) {
+    VertexPtr expr = v.as<meta_op_unary>()->expr();
+    return is_silently_converted(tinf::get_type(expr)) && cannot_fail(expr);
+  }
+  if (auto call = v.try_as<op_func_call>()) {
+    if (call->args().size() != 1 || !cannot_fail(call->args()[0])) {
+      return false;
+    }
+    const TypeData *arg_type = tinf::get_type(call->args()[0]);
+    if (vk::any_of_equal(call->func_id->name, "count", "sizeof")) {
+      return arg_type->ptype() == tp_array && !arg_type->use_optional();
+    }
+    if (call->func_id->name == "strlen") {
+      return arg_type->ptype() == tp_string && !arg_type->use_optional();
+    }
+  }
+  return false;
+}
+
+bool is_side_effect_free(VertexPtr v) {
+  if (is_constant(v)) {
+    return true;
+  }
+  switch (v->type()) {
+    case op_var:
+      return v->rl_type == val_r;
+    case op_instance_prop:
+      return v->rl_type == val_r && is_side_effect_free(v.as<op_instance_prop>()->instance());
+    case op_index:
+      if (!is_readonly_index(v.as<op_index>())) {
+        return false;
+      }
+      break;
+    case op_func_call:
+      if (!is_pure_call(v.as<op_func_call>())) {
+        return false;
+      }
+      break;
+    case op_array:
+    case op_double_arrow:
+      break;
+    default:
+      if (!is_pure_operation(v) && !is_conv_operation(v)) {
+        return false;
+      }
+  }
+  return vk::all_of(*v, is_side_effect_free);
+}
+
+bool is_same_expression(VertexPtr lhs, VertexPtr rhs) {
+  if (lhs->type() != rhs->type() || lhs->size() != rhs->size()) {
+    return false;
+  }
+  switch (lhs->type()) {
+    case op_var:
+      return lhs.as<op_var>()->var_id == rhs.as<op_var>()->var_id;
+    case op_instance_prop:
+      if (lhs.as<op_instance_prop>()->var_id != rhs.as<op_instance_prop>()->var_id) {
+        return false;
+      }
+      break;
+    case op_func_call:
+      if (lhs.as<op_func_call>()->func_id != rhs.as<op_func_call>()->func_id) {
+        return false;
+      }
+      break;
+    case op_int_const:
+    case op_float_const:
+    case op_string:
+      return lhs->get_string() == rhs->get_string();
+    default:
+      break;
+  }
+  return std::equal(lhs->begin(), lhs->end(), rhs->begin(), rhs->end(), is_same_expression);
+}
+
+void mark_all_vars_written(VertexPtr root, std::unordered_set<VarPtr> &written_vars) {
+  if (auto var = root.try_as<op_var>()) {
+    written_vars.insert(var->var_id);
+  }
+  for (auto child : *root) {
+    mark_all_vars_written(child, written_vars);
+  }
+}
+
+void collect_expensive(VertexPtr &v, bool conditional, std::vector<std::pair<VertexPtr *, bool>> &occurrences) {
+  if (is_expensive(v)) {
+    occurrences.emplace_back(&v, conditional);
+  }
+  int child_index = 0;
+  for (auto &child : *v) {
+    if (!is_key_existence_check(v, child_index)) {
+      collect_expensive(child, conditional || is_conditional_child(v, child_index), occurrences);
+    }
+    ++child_index;
+  }
+}
+
+VertexAdaptor<op_var> make_var_usage(VertexAdaptor<op_var> var) {
+  auto usage = var.clone();
+  usage->rl_type = val_r;
+  return usage;
+}
+
+} // namespace
+
+void HoistPureExpressionsPass::collect_loop_info(VertexPtr root, LoopInfo &info) {
+  switch (root->type()) {
+    case op_var:
+      if (root->rl_type != val_r) {
+        info.written_vars.insert(root.as<op_var>()->var_id);
+      }
+      return;
+    case op_instance_prop:
+      if (root->rl_type != val_r) {
+        info.may_modify_instances = true;
+      }
+      break;
+    case op_func_call:
+      if (!is_pure_call(root.as<op_func_call>())) {
+        info.may_modify_instances = true;
+      }
+      break;
+    case op_foreach_param:
+    case op_list:
+    case op_unset:
+      mark_all_vars_written(root, info.written_vars);
+      info.may_modify_instances |= root->type() == op_unset;
+      break;
+    default:
+      break;
+  }
+  for (auto child : *root) {
+    collect_loop_info(child, info);
+  }
+}
+
+bool HoistPureExpressionsPass::is_invariant(VertexPtr v, const LoopInfo &info) {
+  if (is_constant(v)) {
+    return true;
+  }
+  switch (v->type()) {
+    case op_var: {
+      VarPtr var = v.as<op_var>()->var_id;
+      return v->rl_type == val_r && is_readonly_local(var) && !info.written_vars.count(var);
+    }
+    case op_instance_prop:
+      return v->rl_type == val_r && !info.may_modify_instances && is_invariant(v.as<op_instance_prop>()->instance(), info);
+    case op_index:
+      if (!is_readonly_index(v.as<op_index>())) {
+        return false;
+      }
+      break;
+    case op_func_call:
+      if (!is_pure_call(v.as<op_func_call>())) {
+        return false;
+      }
+      break;
+    default:
+      if (!is_pure_operation(v) && !is_conv_operation(v)) {
+        return false;
+      }
+  }
+  return vk::all_of(*v, [&info](VertexPtr child) { return is_invariant(child, info); });
+}
+
+VertexAdaptor<op_var> HoistPureExpressionsPass::hoist(VertexPtr expr, std::vector<Hoisted> &hoisted) {
+  for (const auto &h : hoisted) {
+    if (is_same_expression(h.expr, expr)) {
+      return make_var_usage(h.var);
+    }
+  }
+  auto var = VertexAdaptor<op_var>::create().set_location(expr);
+  var->str_val = gen_unique_name("hoisted");
+  var->var_id = G->create_local_var(current_function, var->str_val, VarData::var_local_t);
+  var->var_id->tinf_node.copy_type_from(tinf::get_type(expr));
+  hoisted.emplace_back(Hoisted{expr, var});
+  ++G->stats.cnt_hoisted_pure_expressions;
+  return make_var_usage(var);
+}
+
+// "prefix_$a_$b_$i" — the invariant part of a concatenation is hoisted, even if the whole one is not invariant
+void HoistPureExpressionsPass::hoist_string_build_runs(VertexPtr &v, const LoopInfo &info, std::vector<Hoisted> &hoisted) {
+  const auto is_hoistable_arg = [&info](VertexPtr arg) {
+    return is_invariant(arg, info) && is_silently_converted(tinf::get_type(arg)) && cannot_fail(arg);
+  };
+
+  std::vector<VertexPtr> new_args;
+  bool changed = false;
+  auto args = v.as<op_string_build>()->args();
+  for (auto it = args.begin(); it != args.end();) {
+    auto run_end = std::find_if_not(it, args.end(), is_hoistable_arg);
+    if (std::distance(it, run_end) >= 2) {
+      auto run = VertexAdaptor<op_string_build>::create(std::vector<VertexPtr>{it, run_end}).set_location(*it);
+      run->rl_type = val_r;
+      new_args.emplace_back(hoist(run, hoisted));
+      changed = true;
+    } else {
+      new_args.insert(new_args.end(), it, run_end);
+    }
+    if (run_end != args.end()) {
+      new_args.emplace_back(*run_end++);
+    }
+    it = run_end;
+  }
+
+  if (changed) {
+    auto new_build = VertexAdaptor<op_string_build>::create(new_args).set_location(v);
+    new_build->rl_type = v->rl_type;
+    v = new_build;
+  }
+}
+
+void HoistPureExpressionsPass::hoist_loop_invariants(VertexPtr &v, bool speculative_only, const LoopInfo &info, std::vector<Hoisted> &hoisted) {
+  if (is_expensive(v) && is_invariant(v, info) && (!speculative_only || cannot_fail(v))) {
+    v = hoist(v, hoisted);
+    return;
+  }
+  if (v->type() == op_string_build) {
+    hoist_string_build_runs(v, info, hoisted);
+  }
+  int child_index = 0;
+  for (auto &child : *v) {
+    if (!is_key_existence_check(v, child_index)) {
+      hoist_loop_invariants(child, speculative_only || is_conditional_child(v, child_index), info, hoisted);
+    }
+    ++child_index;
+  }
+}
+
+std::vector<HoistPureExpressionsPass::Hoisted> HoistPureExpressionsPass::process_loop(VertexPtr loop) {
+  LoopInfo info;
+  collect_loop_info(loop, info);
+
+  std::vector<Hoisted> hoisted;
+  if (auto while_loop = loop.try_as<op_while>()) {
+    hoist_loop_invariants(while_loop->cond(), false, info, hoisted);
+    hoist_loop_invariants(while_loop->cmd_ref(), true, info, hoisted);
+  } else if (auto for_loop = loop.try_as<op_for>()) {
+    // pre_cond() is executed once anyway, and vars written there are not invariant
+    hoist_loop_invariants(for_loop->cond(), false, info, hoisted);
+    hoist_loop_invariants(for_loop->post_cond_ref(), true, info, hoisted);
+    hoist_loop_invariants(for_loop->cmd_ref(), true, info, hoisted);
+  } else if (auto do_loop = loop.try_as<op_do>()) {
+    // the body may break out before the condition is evaluated
+    hoist_loop_invariants(do_loop->cmd_ref(), true, info, hoisted);
+    hoist_loop_invariants(do_loop->cond(), true, info, hoisted);
+  } else if (auto foreach_loop = loop.try_as<op_foreach>()) {
+    hoist_loop_invariants(foreach_loop->cmd_ref(), true, info, hoisted);
+  }
+  return hoisted;
+}
+
+std::vector<HoistPureExpressionsPass::Hoisted> HoistPureExpressionsPass::eliminate_common_subexpressions(VertexPtr stmt) {
+  VertexPtr *area = nullptr;
+  if (auto set = stmt.try_as<op_set>()) {
+    area = set->lhs()->type() == op_var ? &set->rhs() : nullptr;
+  } else if (auto ret = stmt.try_as<op_return>()) {
+    area = ret->has_expr() ? &ret->expr() : nullptr;
+  } else if (auto if_stmt = stmt.try_as<op_if>()) {
+    area = &if_stmt->cond();
+  } else if (stmt->type() == op_func_call) {
+    area = &stmt;
+  }
+  if (!area) {
+    return {};
+  }
+
+  // f($a['k'], $a['k']) — f() itself may be not pure, it's called after all arguments are evaluated
+  std::vector<VertexPtr *> roots;
+  auto call = area->try_as<op_func_call>();
+  if (call && !is_pure_call(call)) {
+    if (!call->func_id || vk::any_of(call->func_id->param_ids, [](VarPtr param) { return param->is_reference; })) {
+      return {};
+    }
+    for (auto &arg : call->args()) {
+      roots.emplace_back(&arg);
+    }
+  } else {
+    roots.emplace_back(area);
+  }
+  if (!vk::all_of(roots, [](VertexPtr *root) { return is_side_effect_free(*root); })) {
+    return {};
+  }
+
+  std::vector<Hoisted> hoisted;
+  while (true) {
+    std::vector<std::pair<VertexPtr *, bool>> occurrences;
+    for (VertexPtr *root : roots) {
+      collect_expensive(*root, false, occurrences);
+    }
+
+    VertexPtr repeated;
+    for (size_t i = 0; i < occurrences.size() && !repeated; ++i) {
+      for (size_t j = i + 1; j < occurrences.size() && !repeated; ++j) {
+        const bool evaluated_anyway = !occurrences[i].second || !occurrences[j].second;
+        if (evaluated_anyway && is_same_expression(*occurrences[i].first, *occurrences[j].first)) {
+          repeated = *occurrences[i].first;
+        }
+      }
+    }
+    if (!repeated) {
+      break;
+    }
+
+    // equal expressions can't be nested, so replacing one doesn't invalidate pointers to others
+    for (auto &occurrence : occurrences) {
+      if (is_same_expression(*occurrence.first, repeated)) {
+        *occurrence.first = hoist(repeated, hoisted);
+      }
+    }
+  }
+  return hoisted;
+}
+
+bool HoistPureExpressionsPass::check_function(FunctionPtr function) const {
+  return !function->is_extern() && !function->is_main_function() && function->type != FunctionData::func_class_holder;
+}
+
+VertexPtr HoistPureExpressionsPass::on_enter_vertex(VertexPtr root) {
+  auto seq = root.try_as<op_seq>();
+  if (!seq) {
+    return root;
+  }
+
+  std::vector<VertexPtr> new_stmts;
+  bool changed = false;
+  for (auto &stmt : seq->args()) {
+    const bool is_loop = vk::any_of_equal(stmt->type(), op_while, op_for, op_do, op_foreach);
+    auto hoisted = is_loop ? process_loop(stmt) : eliminate_common_subexpressions(stmt);
+    for (const auto &h : hoisted) {
+      auto lhs = h.var.clone();
+      lhs->rl_type = val_l;
+      auto set = VertexAdaptor<op_set>::create(lhs, h.expr).set_location(h.expr);
+      set->rl_type = val_none;
+      new_stmts.emplace_back(set);
+    }
+    changed |= !hoisted.empty();
+    new_stmts.emplace_back(stmt);
+  }
+
+  if (!changed) {
+    return root;
+  }
+  auto new_seq = VertexAdaptor<op_seq>::create(new_stmts).set_location(seq);
+  new_seq->rl_type = seq->rl_type;
+  return new_seq;
+}
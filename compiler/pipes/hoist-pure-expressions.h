@@ -0,0 +1,42 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#pragma once
+
+#include <unordered_set>
+
+#include "compiler/function-pass.h"
+
+// loop-invariant code motion and common subexpression elimination for pure expressions:
+// invariant ones are computed before a loop, repeated ones are computed once before a statement
+class HoistPureExpressionsPass final : public FunctionPassBase {
+  struct LoopInfo {
+    std::unordered_set<VarPtr> written_vars;
+    bool may_modify_instances{false};
+  };
+
+  struct Hoisted {
+    VertexPtr expr;
+    VertexAdaptor<op_var> var;
+  };
+
+  static void collect_loop_info(VertexPtr root, LoopInfo &info);
+  static bool is_invariant(VertexPtr v, const LoopInfo &info);
+
+  VertexAdaptor<op_var> hoist(VertexPtr expr, std::vector<Hoisted> &hoisted);
+  void hoist_string_build_runs(VertexPtr &v, const LoopInfo &info, std::vector<Hoisted> &hoisted);
+  void hoist_loop_invariants(VertexPtr &v, bool speculative_only, const LoopInfo &info, std::vector<Hoisted> &hoisted);
+  std::vector<Hoisted> process_loop(VertexPtr loop);
+
+  std::vector<Hoisted> eliminate_common_subexpressions(VertexPtr stmt);
+
+public:
+  std::string get_description() override {
+    return "Hoist pure expressions";
+  }
+
+  bool check_function(FunctionPtr function) const override;
+
+  VertexPtr on_enter_vertex(VertexPtr root) override;
+};
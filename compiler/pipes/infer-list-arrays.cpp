@@ -0,0 +1,123 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#include "compiler/pipes/infer-list-arrays.h"
+
+#include "compiler/compiler-core.h"
+#include "compiler/data/var-data.h"
+#include "compiler/inferring/public.h"
+#include "compiler/vertex-util.h"
+
+// a local array is a list (a vector at runtime), if it's written only by
+// * assignments of list literals [a, b, c] (without keys and spreads), of other list vars, of builtins returning vectors
+// * appends $a[] = x (a vector stays a vector on push_back)
+// any other modification ($a[$k] = x, unset, passing by reference, foreach by reference) makes it a usual array;
+// an uninitialized array is an empty vector
+//
+// foreach ($list as $i => $v) is compiled into a loop over const T* instead of array_iterator,
+// which checks is_vector() on every get_value() / get_key() / operator++
+
+namespace {
+
+bool is_array_candidate(VarPtr var) {
+  if (var->type() != VarData::var_local_t || var->is_reference || var->is_foreach_reference) {
+    return false;
+  }
+  const TypeData *type = tinf::get_type(var);
+  return type->ptype() == tp_array && !type->use_optional();
+}
+
+bool is_vector_returning_builtin(FunctionPtr function) {
+  // see runtime: they are filled by push_back() into array_size(n, true)
+  return function && function->is_extern() &&
+         vk::any_of_equal(function->name, "explode", "array_values", "array_keys", "str_split");
+}
+
+} // namespace
+
+void InferListArraysPass::collect_writes(VertexPtr root) {
+  if (auto set = root.try_as<op_set>()) {
+    if (auto lhs = set->lhs().try_as<op_var>()) {
+      assigned_values_[lhs->var_id].emplace_back(set->rhs());
+      collect_writes(set->rhs());
+      return;
+    }
+  } else if (auto push_back = root.try_as<meta_op_push_back>()) {
+    if (push_back->array()->type() == op_var) {
+      collect_writes(push_back->value());
+      return;
+    }
+  } else if (auto param = root.try_as<op_foreach_param>()) {
+    // a temp var is assigned implicitly in codegen, see on_enter_vertex()
+    if (auto temp_var = param->temp_var().try_as<op_var>()) {
+      non_list_vars_.insert(temp_var->var_id);
+    }
+  } else if (auto var = root.try_as<op_var>()) {
+    if (var->rl_type != val_r && var->rl_type != val_none) {
+      non_list_vars_.insert(var->var_id);
+    }
+    return;
+  }
+  for (auto child : *root) {
+    collect_writes(child);
+  }
+}
+
+bool InferListArraysPass::is_list_var(VertexPtr v) const {
+  auto var = v.try_as<op_var>();
+  return var && var->var_id && var->var_id->is_list_array;
+}
+
+bool InferListArraysPass::is_list_value(VertexPtr v) const {
+  v = VertexUtil::get_actual_value(v);
+  if (auto array = v.try_as<op_array>()) {
+    return vk::all_of(*array, [](VertexPtr item) { return vk::none_of_equal(item->type(), op_double_arrow, op_varg); });
+  }
+  if (auto call = v.try_as<op_func_call>()) {
+    return is_vector_returning_builtin(call->func_id);
+  }
+  return is_list_var(v);
+}
+
+bool InferListArraysPass::check_function(FunctionPtr function) const {
+  return !function->is_extern() && function->type != FunctionData::func_class_holder;
+}
+
+void InferListArraysPass::on_start() {
+  collect_writes(current_function->root);
+
+  std::vector<VarPtr> list_vars;
+  for (VarPtr var : current_function->local_var_ids) {
+    if (is_array_candidate(var) && !non_list_vars_.count(var)) {
+      var->is_list_array = true;
+      list_vars.emplace_back(var);
+    }
+  }
+  // $a = $b makes $a a list only if $b is a list, so exclude vars until nothing changes
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (VarPtr var : list_vars) {
+      if (var->is_list_array) {
+        const auto &values = assigned_values_[var];
+        if (!std::all_of(values.begin(), values.end(), [this](VertexPtr v) { return is_list_value(v); })) {
+          var->is_list_array = false;
+          changed = true;
+        }
+      }
+    }
+  }
+  G->stats.cnt_list_arrays += std::count_if(list_vars.begin(), list_vars.end(), [](VarPtr var) { return var->is_list_array; });
+}
+
+VertexPtr InferListArraysPass::on_enter_vertex(VertexPtr root) {
+  if (auto param = root.try_as<op_foreach_param>()) {
+    auto temp_var = param->temp_var().try_as<op_var>();
+    if (!param->x()->ref_flag && temp_var && temp_var->var_id->needs_const_iterator_flag && is_list_var(param->xs())) {
+      // the temp var holds a copy of the list (or its conversion, which keeps a vector a vector)
+      temp_var->var_id->is_list_array = true;
+    }
+  }
+  return root;
+}
@@ -0,0 +1,32 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#pragma once
+
+#include <unordered_map>
+#include <unordered_set>
+
+#include "compiler/function-pass.h"
+
+// finds local arrays, that are always vectors at runtime (lists): they are built only from list literals and appends;
+// foreach over such an array iterates over a raw vector storage, and $a[$i] skips the is_vector() check
+class InferListArraysPass final : public FunctionPassBase {
+  std::unordered_map<VarPtr, std::vector<VertexPtr>> assigned_values_;
+  std::unordered_set<VarPtr> non_list_vars_;
+
+  void collect_writes(VertexPtr root);
+  bool is_list_value(VertexPtr v) const;
+  bool is_list_var(VertexPtr v) const;
+
+public:
+  std::string get_description() override {
+    return "Infer list arrays";
+  }
+
+  bool check_function(FunctionPtr function) const override;
+
+  void on_start() override;
+
+  VertexPtr on_enter_vertex(VertexPtr root) override;
+};
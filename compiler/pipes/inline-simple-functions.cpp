@@ -4,12 +4,55 @@
 
 #include "compiler/pipes/inline-simple-functions.h"
 
+#include "compiler/compiler-core.h"
 #include "compiler/data/src-file.h"
 #include "compiler/data/var-data.h"
 #include "compiler/inferring/public.h"
 
+static constexpr InlineSimpleFunctions::InlineBudget default_inline_budget{6, 5, 2};
+
+// the cost model is based on call sites of a function (see CalcBadVars):
+// * a function called only once doesn't blow up the code when inlined, so a rather big one is allowed
+// * calls inside loops are hot, the call overhead is more noticeable there
+// * constant arguments let gcc fold the inlined body after inlining
+// * a recursive function can't be inlined entirely, so it gets only the default budget
+// * if there is a profile of a running site (--function-profile), it overrides the guess about loops:
+//   hot functions get the largest budget, and cold ones are inlined only if they are really tiny
+InlineSimpleFunctions::InlineBudget InlineSimpleFunctions::calc_budget(FunctionPtr function) noexcept {
+  InlineBudget budget = default_inline_budget;
+  if (function->profile_hotness == FunctionData::profile_hotness_t::cold || function->call_sites_recursive > 0) {
+    return budget;
+  }
+  if (function->call_sites_total == 1 || function->profile_hotness == FunctionData::profile_hotness_t::hot) {
+    budget = {20, 12, 6};
+  } else if (function->call_sites_in_loops > 0 && function->call_sites_total <= 8) {
+    budget = {12, 8, 4};
+  }
+  if (function->call_sites_with_const_args * 2 >= function->call_sites_total && function->call_sites_total > 0) {
+    budget.max_simple_operations += 4;
+  }
+  return budget;
+}
+
+void InlineSimpleFunctions::on_start() {
+  budget_ = calc_budget(current_function);
+}
+
 void InlineSimpleFunctions::on_simple_operation() noexcept {
-  if (++n_simple_operations_ > 6) {
+  ++n_simple_operations_;
+  if (n_simple_operations_ > default_inline_budget.max_simple_operations) {
+    fits_default_budget_ = false;
+  }
+  if (n_simple_operations_ > budget_.max_simple_operations) {
+    inline_is_possible_ = false;
+  }
+}
+
+void InlineSimpleFunctions::on_sized_vertex(int size, int max_size, int default_max_size) noexcept {
+  if (size > default_max_size) {
+    fits_default_budget_ = false;
+  }
+  if (size > max_size) {
     inline_is_possible_ = false;
   }
 }
@@ -48,6 +91,7 @@ VertexPtr InlineSimpleFunctions::on_enter_vertex(VertexPtr root) {
     case op_ffi_load_call:
     case op_ffi_php2c_conv:
     case op_ffi_c2php_conv:
+    case op_array_refill:
       break;
     case op_func_name:
     case op_func_call:
@@ -67,17 +111,13 @@ VertexPtr InlineSimpleFunctions::on_enter_vertex(VertexPtr root) {
       in_param_list_ = true;
       // fallthrough
     case op_seq:
-      if (root->size() > 5) {
-        inline_is_possible_ = false;
-      }
+      on_sized_vertex(root->size(), budget_.max_seq_size, default_inline_budget.max_seq_size);
       break;
     case op_string_build:
     case op_array:
     case op_tuple:
     case op_shape:
-      if (root->size() > 2) {
-        inline_is_possible_ = false;
-      }
+      on_sized_vertex(root->size(), budget_.max_constructor_size, default_inline_budget.max_constructor_size);
       break;
     default:
       inline_is_possible_ = false;
@@ -110,6 +150,9 @@ bool InlineSimpleFunctions::check_function(FunctionPtr function) const {
 void InlineSimpleFunctions::on_finish() {
   if (inline_is_possible_) {
     current_function->is_inline = true;
+    if (!fits_default_budget_) {
+      ++G->stats.cnt_inline_by_cost_model;
+    }
   }
   return FunctionPassBase::on_finish();
 }
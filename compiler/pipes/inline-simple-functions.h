@@ -6,17 +6,33 @@
 
 #include "compiler/function-pass.h"
 
+// a function is marked inline (its body is placed in a header, so gcc can inline it into callers from other TUs)
+// if its body is small enough; how much is "small enough" depends on how it's called, see calc_budget()
 class InlineSimpleFunctions final : public FunctionPassBase {
+public:
+  struct InlineBudget {
+    int max_simple_operations;
+    int max_seq_size;
+    int max_constructor_size;   // for string building, array/tuple/shape creation
+  };
+
 private:
   bool inline_is_possible_{true};
   int n_simple_operations_{0};
   bool in_param_list_{false};
+  InlineBudget budget_{};
+  bool fits_default_budget_{true};
 
   void on_simple_operation() noexcept;
+  void on_sized_vertex(int size, int max_size, int default_max_size) noexcept;
+
+  static InlineBudget calc_budget(FunctionPtr function) noexcept;
 
 public:
   std::string get_description() final { return "Inline simple functions"; }
 
+  void on_start() final;
+
   VertexPtr on_enter_vertex(VertexPtr root) final;
   VertexPtr on_exit_vertex(VertexPtr root) final;
   bool user_recursion(VertexPtr) final;
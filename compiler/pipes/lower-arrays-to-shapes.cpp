@@ -0,0 +1,105 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#include "compiler/pipes/lower-arrays-to-shapes.h"
+
+#include "compiler/compiler-core.h"
+#include "compiler/data/var-data.h"
+
+// it's done after rl types are calculated, but before type inferring, as the var just becomes a shape for the inferrer;
+// the conditions for a var are:
+// * it's assigned exactly once, by a statement $row = [...] with unique constant string keys
+// * all other usages are reads $row['key'] (not isset/unset, not writes) by keys from the literal
+// * all these reads are in the statements following the assignment in the same block,
+//   so they are never executed before it (if the block is a loop body, the var is reassigned on every iteration)
+// passing $row anywhere (to a function, to a lambda, in a return) keeps it an array
+
+bool LowerArraysToShapesPass::collect_literal_keys(VertexAdaptor<op_array> array, std::set<std::string> &keys) {
+  if (array->empty()) {
+    return false;
+  }
+  for (auto item : *array) {
+    auto arrow = item.try_as<op_double_arrow>();
+    auto key = arrow ? arrow->key().try_as<op_string>() : VertexAdaptor<op_string>{};
+    if (!key || !keys.insert(key->get_string()).second) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void LowerArraysToShapesPass::count_var_usages(VertexPtr root) {
+  if (auto var = root.try_as<op_var>()) {
+    if (var->var_id) {
+      ++var_usages_[var->var_id];
+    }
+    return;
+  }
+  for (auto child : *root) {
+    count_var_usages(child);
+  }
+}
+
+int LowerArraysToShapesPass::count_reads_by_keys(VertexPtr root, VarPtr var, const std::set<std::string> &keys) {
+  if (vk::any_of_equal(root->type(), op_isset, op_unset)) {
+    return 0;
+  }
+  if (auto index = root.try_as<op_index>()) {
+    auto array = index->array().try_as<op_var>();
+    if (array && array->var_id == var) {
+      auto key = index->has_key() ? index->key().try_as<op_string>() : VertexAdaptor<op_string>{};
+      return key && keys.count(key->get_string()) && index->rl_type == val_r;
+    }
+  }
+  int reads = 0;
+  for (auto child : *root) {
+    reads += count_reads_by_keys(child, var, keys);
+  }
+  return reads;
+}
+
+void LowerArraysToShapesPass::try_lower_to_shape(VertexAdaptor<op_seq> seq, int stmt_index) {
+  auto set = seq->args()[stmt_index].try_as<op_set>();
+  auto lhs = set ? set->lhs().try_as<op_var>() : VertexAdaptor<op_var>{};
+  auto array = set ? set->rhs().try_as<op_array>() : VertexAdaptor<op_array>{};
+  if (!lhs || !array || !lhs->var_id || lhs->var_id->type() != VarData::var_local_t || lhs->var_id->is_reference) {
+    return;
+  }
+  std::set<std::string> keys;
+  if (!collect_literal_keys(array, keys)) {
+    return;
+  }
+
+  VarPtr var = lhs->var_id;
+  int reads = 0;
+  for (int i = stmt_index + 1; i < seq->size(); ++i) {
+    reads += count_reads_by_keys(seq->args()[i], var, keys);
+  }
+  // all usages except the assignment itself are reads by keys, and they are after the assignment
+  if (reads == 0 || reads + 1 != var_usages_[var]) {
+    return;
+  }
+
+  auto shape = VertexAdaptor<op_shape>::create(array->args()).set_location(array);
+  shape->rl_type = array->rl_type;
+  set->rhs() = shape;
+  ++G->stats.cnt_arrays_lowered_to_shapes;
+}
+
+bool LowerArraysToShapesPass::check_function(FunctionPtr function) const {
+  return !function->is_extern() && function->type != FunctionData::func_class_holder;
+}
+
+void LowerArraysToShapesPass::on_start() {
+  count_var_usages(current_function->root);
+}
+
+VertexPtr LowerArraysToShapesPass::on_enter_vertex(VertexPtr root) {
+  if (auto seq = root.try_as<op_seq>()) {
+    for (int i = 0; i < seq->size(); ++i) {
+      try_lower_to_shape(seq, i);
+    }
+  }
+  return root;
+}
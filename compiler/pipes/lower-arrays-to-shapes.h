@@ -0,0 +1,33 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#pragma once
+
+#include <set>
+#include <unordered_map>
+
+#include "compiler/function-pass.h"
+
+// $row = ['id' => $id, 'name' => $name]; ... $row['id'] ...
+// a local array, that is created by a literal with constant string keys and then only read by these keys,
+// is turned into a shape: $row['id'] becomes a field access instead of a hash lookup
+class LowerArraysToShapesPass final : public FunctionPassBase {
+  std::unordered_map<VarPtr, int> var_usages_;
+
+  void count_var_usages(VertexPtr root);
+  static int count_reads_by_keys(VertexPtr root, VarPtr var, const std::set<std::string> &keys);
+  static bool collect_literal_keys(VertexAdaptor<op_array> array, std::set<std::string> &keys);
+  void try_lower_to_shape(VertexAdaptor<op_seq> seq, int stmt_index);
+
+public:
+  std::string get_description() override {
+    return "Lower arrays to shapes";
+  }
+
+  bool check_function(FunctionPtr function) const override;
+
+  void on_start() override;
+
+  VertexPtr on_enter_vertex(VertexPtr root) override;
+};
@@ -0,0 +1,149 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#include "compiler/pipes/move-last-usages.h"
+
+#include "compiler/data/var-data.h"
+#include "compiler/inferring/public.h"
+
+// a liveness analysis restricted to the top-level statements of a function body:
+// they are executed exactly once and in order (there are no loops and no try blocks around them),
+// so a local var that is not mentioned in the following statements is dead after the current one;
+// if such a var is also mentioned only once in the current statement, this usage may be moved from
+//
+// function add_one(array $a) { $a[] = 1; return $a; }
+// $arr = add_one($arr);          // $arr is overwritten, so it's moved into add_one() and not cloned on append
+// $this->items = $items;         // if $items isn't used below, it's moved into a field without a refcount increment
+// return $items;                 // a return with a conversion (array to mixed, for example)
+//
+// a moved-from var is never read again, so it doesn't matter what's left in it;
+// if a statement throws, the var is gone anyway, as a top-level statement can't be inside a try block
+//
+// deeper in a body (in loops, for example) only $x = f($x) is handled: $x is overwritten right after the call,
+// unless the call throws — that's why it's not done inside try blocks
+
+bool MoveLastUsagesPass::is_movable_var(VertexPtr v) {
+  auto var_vertex = v.try_as<op_var>();
+  if (!var_vertex || !var_vertex->var_id) {
+    return false;
+  }
+  VarPtr var = var_vertex->var_id;
+  if (!vk::any_of_equal(var->type(), VarData::var_local_t, VarData::var_param_t) || var->is_reference || var->is_foreach_reference) {
+    return false;
+  }
+  const TypeData *type = tinf::get_type(var);
+  return vk::any_of_equal(type->ptype(), tp_array, tp_string, tp_mixed) && !type->use_optional();
+}
+
+int MoveLastUsagesPass::count_var_usages(VertexPtr root, VarPtr var) {
+  if (auto var_vertex = root.try_as<op_var>()) {
+    return var_vertex->var_id == var;
+  }
+  int usages = 0;
+  for (auto child : *root) {
+    usages += count_var_usages(child, var);
+  }
+  return usages;
+}
+
+bool MoveLastUsagesPass::is_used_after(VarPtr var, int stmt_index) const {
+  for (int i = stmt_index + 1; i < body_->size(); ++i) {
+    if (count_var_usages(body_->args()[i], var)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void MoveLastUsagesPass::try_move_call_args(VertexAdaptor<op_func_call> call, VertexPtr stmt, int stmt_index, VarPtr overwritten_var) {
+  FunctionPtr callee = call->func_id;
+  if (!callee || callee->is_extern() || callee->is_resumable) {
+    return;
+  }
+
+  const auto &params = callee->param_ids;
+  const size_t non_variadic_params = callee->has_variadic_param ? params.size() - 1 : params.size();
+  auto args = call->args();
+  for (size_t i = 0; i < std::min(non_variadic_params, static_cast<size_t>(args.size())); ++i) {
+    VertexPtr &arg = args[i];
+    if (params[i]->is_reference || !is_movable_var(arg)) {
+      continue;
+    }
+    VarPtr var = arg.as<op_var>()->var_id;
+    // $x = f($x) — $x is mentioned on the left as well, but it's written after the call
+    const int allowed_usages = var == overwritten_var ? 2 : 1;
+    if (count_var_usages(stmt, var) == allowed_usages && (var == overwritten_var || (stmt_index >= 0 && !is_used_after(var, stmt_index)))) {
+      arg = VertexAdaptor<op_move>::create(arg).set_rl_type(val_r).set_location(arg);
+    }
+  }
+}
+
+void MoveLastUsagesPass::process_statement(VertexPtr &stmt, int stmt_index) {
+  if (auto set = stmt.try_as<op_set>()) {
+    VarPtr overwritten_var = set->lhs()->type() == op_var ? set->lhs().as<op_var>()->var_id : VarPtr{};
+    if (auto call = set->rhs().try_as<op_func_call>()) {
+      try_move_call_args(call, stmt, stmt_index, overwritten_var);
+    } else if (is_movable_var(set->rhs())) {
+      VarPtr var = set->rhs().as<op_var>()->var_id;
+      if (var != overwritten_var && count_var_usages(stmt, var) == 1 && !is_used_after(var, stmt_index)) {
+        set->rhs() = VertexAdaptor<op_move>::create(set->rhs()).set_rl_type(val_r).set_location(set->rhs());
+      }
+    }
+  } else if (auto call = stmt.try_as<op_func_call>()) {
+    try_move_call_args(call, stmt, stmt_index, {});
+  } else if (auto ret = stmt.try_as<op_return>()) {
+    if (!ret->has_expr()) {
+      return;
+    }
+    if (auto call = ret->expr().try_as<op_func_call>()) {
+      try_move_call_args(call, stmt, stmt_index, {});
+    } else if (is_movable_var(ret->expr())) {
+      // returning a local of the same type is already an implicit move in C++, and an explicit one only prevents copy elision
+      const TypeData *var_type = tinf::get_type(ret->expr().as<op_var>()->var_id);
+      if (!are_equal_types(var_type, tinf::get_type(current_function, -1))) {
+        ret->expr() = VertexAdaptor<op_move>::create(ret->expr()).set_rl_type(val_r).set_location(ret->expr());
+      }
+    }
+  }
+}
+
+void MoveLastUsagesPass::process_nested_statement(VertexPtr stmt) {
+  if (auto set = stmt.try_as<op_set>()) {
+    if (set->lhs()->type() == op_var) {
+      if (auto call = set->rhs().try_as<op_func_call>()) {
+        try_move_call_args(call, stmt, -1, set->lhs().as<op_var>()->var_id);
+      }
+    }
+  }
+}
+
+bool MoveLastUsagesPass::check_function(FunctionPtr function) const {
+  return !function->is_extern() && !function->is_resumable && !function->is_main_function() &&
+         function->type != FunctionData::func_class_holder;
+}
+
+VertexPtr MoveLastUsagesPass::on_enter_vertex(VertexPtr root) {
+  if (auto func = root.try_as<op_function>()) {
+    body_ = func->cmd();
+    for (int i = 0; i < body_->size(); ++i) {
+      process_statement(body_->args()[i], i);
+    }
+  } else if (root->type() == op_try) {
+    ++try_depth_;
+  } else if (auto seq = root.try_as<op_seq>()) {
+    if (seq != body_ && try_depth_ == 0) {
+      for (auto stmt : seq->args()) {
+        process_nested_statement(stmt);
+      }
+    }
+  }
+  return root;
+}
+
+VertexPtr MoveLastUsagesPass::on_exit_vertex(VertexPtr root) {
+  if (root->type() == op_try) {
+    --try_depth_;
+  }
+  return root;
+}
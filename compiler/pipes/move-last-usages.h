@@ -0,0 +1,32 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#pragma once
+
+#include "compiler/function-pass.h"
+
+// wraps the last usages of local arrays/strings/mixed into std::move(),
+// to avoid refcount increments and copy-on-write clones of values that are never read afterwards
+class MoveLastUsagesPass final : public FunctionPassBase {
+  static bool is_movable_var(VertexPtr v);
+  static int count_var_usages(VertexPtr root, VarPtr var);
+  bool is_used_after(VarPtr var, int stmt_index) const;
+
+  void try_move_call_args(VertexAdaptor<op_func_call> call, VertexPtr stmt, int stmt_index, VarPtr overwritten_var);
+  void process_statement(VertexPtr &stmt, int stmt_index);
+  void process_nested_statement(VertexPtr stmt);
+
+  VertexAdaptor<op_seq> body_;
+  int try_depth_{0};
+
+public:
+  std::string get_description() override {
+    return "Move last usages";
+  }
+
+  bool check_function(FunctionPtr function) const override;
+
+  VertexPtr on_enter_vertex(VertexPtr root) override;
+  VertexPtr on_exit_vertex(VertexPtr root) override;
+};
@@ -0,0 +1,96 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#include "compiler/pipes/reuse-array-literals.h"
+
+#include "compiler/compiler-core.h"
+#include "compiler/data/var-data.h"
+#include "compiler/inferring/public.h"
+#include "compiler/name-gen.h"
+
+// an array literal passed to a builtin is usually a temporary, that dies right after the call:
+//
+// foreach ($rows as $row) {
+//   $line = implode(',', [$row->id, $row->name]);     // allocates and frees a buffer on every iteration
+// }
+//
+// such literals are bound to a hidden local var, and codegen emits v$refill_array.refill_vector($row->id, ...):
+// when nobody holds the previous array, its buffer is overwritten in place, otherwise a new one is allocated;
+// it means that a builtin, that saved the array somewhere (e.g. into instance cache), still gets a copy-on-write value,
+// so "doesn't escape" below is only a profitability heuristic, not a correctness requirement
+
+bool ReuseArrayLiteralsPass::is_reusable_literal(VertexAdaptor<op_array> array) {
+  if (array->args().empty() || array->args().size() > 10 || array->extra_type == op_ex_safe_version) {
+    return false;
+  }
+  for (auto arg : array->args()) {
+    if (arg->type() == op_double_arrow) {
+      return false;
+    }
+  }
+  const TypeData *type = tinf::get_type(array);
+  return type->ptype() == tp_array && !type->use_optional();
+}
+
+// a builtin returning a scalar can't return (a part of) the array being passed,
+// so the array is usually free right after the call, and the next iteration reuses the buffer
+bool ReuseArrayLiteralsPass::does_not_escape(VertexAdaptor<op_func_call> call) {
+  FunctionPtr callee = call->func_id;
+  if (!callee || !callee->is_extern() || callee->is_resumable) {
+    return false;
+  }
+  return vk::any_of_equal(tinf::get_type(call)->ptype(), tp_bool, tp_int, tp_float, tp_string, tp_void);
+}
+
+VertexPtr ReuseArrayLiteralsPass::make_refill(VertexAdaptor<op_array> array) {
+  auto tmp_var = VertexAdaptor<op_var>::create().set_location(array);
+  tmp_var->str_val = gen_unique_name("refill_array");
+  tmp_var->var_id = G->create_local_var(current_function, tmp_var->str_val, VarData::var_local_t);
+  tmp_var->var_id->tinf_node.copy_type_from(tinf::get_type(array));
+  tmp_var->rl_type = val_r;
+
+  auto refill = VertexAdaptor<op_array_refill>::create(tmp_var, array).set_location(array);
+  refill->rl_type = array->rl_type;
+  refill->val_ref_flag = array->val_ref_flag;
+  ++G->stats.cnt_refilled_array_literals;
+  return refill;
+}
+
+bool ReuseArrayLiteralsPass::check_function(FunctionPtr function) const {
+  return !function->is_extern() && function->type != FunctionData::func_class_holder;
+}
+
+VertexPtr ReuseArrayLiteralsPass::on_enter_vertex(VertexPtr root) {
+  if (vk::any_of_equal(root->type(), op_for, op_while, op_do, op_foreach)) {
+    ++loops_depth_;
+    return root;
+  }
+
+  auto call = root.try_as<op_func_call>();
+  if (!call || loops_depth_ == 0 || !does_not_escape(call)) {
+    return root;
+  }
+
+  const auto &params = call->func_id->param_ids;
+  auto args = call->args();
+  for (size_t i = 0; i < std::min(params.size(), static_cast<size_t>(args.size())); ++i) {
+    if (params[i]->is_reference) {
+      continue;
+    }
+    VertexPtr &arg = args[i]->type() == op_conv_array ? args[i].as<op_conv_array>()->expr() : args[i];
+    if (auto array = arg.try_as<op_array>()) {
+      if (is_reusable_literal(array)) {
+        arg = make_refill(array);
+      }
+    }
+  }
+  return root;
+}
+
+VertexPtr ReuseArrayLiteralsPass::on_exit_vertex(VertexPtr root) {
+  if (vk::any_of_equal(root->type(), op_for, op_while, op_do, op_foreach)) {
+    --loops_depth_;
+  }
+  return root;
+}
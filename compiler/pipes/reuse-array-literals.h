@@ -0,0 +1,28 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#pragma once
+
+#include "compiler/function-pass.h"
+
+// replaces short-lived array literals inside loops with refilling of a hidden local var,
+// so that a buffer is allocated once per function call instead of once per iteration
+class ReuseArrayLiteralsPass final : public FunctionPassBase {
+  static bool is_reusable_literal(VertexAdaptor<op_array> array);
+  static bool does_not_escape(VertexAdaptor<op_func_call> call);
+
+  VertexPtr make_refill(VertexAdaptor<op_array> array);
+
+  int loops_depth_{0};
+
+public:
+  std::string get_description() override {
+    return "Reuse array literals";
+  }
+
+  bool check_function(FunctionPtr function) const override;
+
+  VertexPtr on_enter_vertex(VertexPtr root) override;
+  VertexPtr on_exit_vertex(VertexPtr root) override;
+};
@@ -243,8 +243,12 @@ VertexPtr to_tmp_string_expr(VertexPtr v, bool safe) {
     return {};
   }
   if (safe) {
-    // the $subject string is always the first argument
-    auto subject_arg = VertexUtil::unwrap_string_value(as_call->args()[0]);
+    // the $subject string is the readonly param: the first argument of substr(), but the second one of explode()
+    const int subject_index = std::max<int>(as_call->func_id->readonly_param_index, 0);
+    if (as_call->args().size() <= subject_index) {
+      return {};
+    }
+    auto subject_arg = VertexUtil::unwrap_string_value(as_call->args()[subject_index]);
     if (!is_safe_simple_expr(subject_arg)) {
       return {};
     }
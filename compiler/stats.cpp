@@ -68,16 +68,23 @@ void Stats::write_to(std::ostream &out, bool with_indent) const {
   out << indent << "vars.global_const: " << global_const_vars_ << std::endl;
   out << indent << "vars.param: " << param_vars_ << std::endl;
   out << indent << "vars.param_make_clone: " << cnt_make_clone << std::endl;
+  out << indent << "vars.refilled_array_literals: " << cnt_refilled_array_literals << std::endl;
+  out << indent << "vars.hoisted_pure_expressions: " << cnt_hoisted_pure_expressions << std::endl;
+  out << indent << "vars.list_arrays: " << cnt_list_arrays << std::endl;
+  out << indent << "vars.arrays_lowered_to_shapes: " << cnt_arrays_lowered_to_shapes << std::endl;
   out << block_sep;
   out << indent << "types.instance: " << instance_vars_ << std::endl;
   out << indent << "types.local_mixed: " << cnt_mixed_vars << std::endl;
   out << indent << "types.params_mixed: " << cnt_mixed_params << std::endl;
   out << indent << "types.const_params_mixed: " << cnt_const_mixed_params << std::endl;
+  out << indent << "types.inferring_split_tasks: " << cnt_type_inferer_split_tasks << std::endl;
   out << block_sep;
   out << indent << "functions.total: " << total_functions_ << std::endl;
   out << indent << "functions.total_inline: " << total_inline_functions_ << std::endl;
+  out << indent << "functions.inline_by_cost_model: " << cnt_inline_by_cost_model << std::endl;
   out << indent << "functions.total_throwing: " << total_throwing_functions_ << std::endl;
   out << indent << "functions.total_resumable: " << total_resumable_functions_ << std::endl;
+  out << indent << "functions.devirtualized_calls: " << cnt_devirtualized_calls << std::endl;
   out << block_sep;
   out << indent << "memory.rss: " << memory_rss_ * 1024 << std::endl;
   out << indent << "memory.rss_peak: " << memory_rss_peak_ * 1024 << std::endl;
@@ -25,6 +25,13 @@ public:
   std::atomic<std::uint64_t> cnt_mixed_vars{0u};
   std::atomic<std::uint64_t> cnt_const_mixed_params{0u};
   std::atomic<std::uint64_t> cnt_make_clone{0u};
+  std::atomic<std::uint64_t> cnt_devirtualized_calls{0u};
+  std::atomic<std::uint64_t> cnt_inline_by_cost_model{0u};
+  std::atomic<std::uint64_t> cnt_refilled_array_literals{0u};
+  std::atomic<std::uint64_t> cnt_hoisted_pure_expressions{0u};
+  std::atomic<std::uint64_t> cnt_list_arrays{0u};
+  std::atomic<std::uint64_t> cnt_arrays_lowered_to_shapes{0u};
+  std::atomic<std::uint64_t> cnt_type_inferer_split_tasks{0u};
 
   std::atomic<std::uint64_t> object_out_size{0u};
   std::atomic<double> transpilation_time{0.0};
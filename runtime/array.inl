@@ -990,6 +990,25 @@ inline array<T> array<T>::create(Args &&... args) {
   return res;
 }
 
+template<class T>
+template<class... Args>
+inline array<T> &array<T>::refill_vector(Args &&... args) {
+  static_assert((std::is_convertible<std::decay_t<Args>, T>::value && ...), "Args type must be convertible to T");
+
+  if (p->ref_cnt != 0 || !p->is_vector() || p->buf_size < sizeof...(args)) {
+    *this = create(std::forward<Args>(args)...);
+    return *this;
+  }
+
+  for (uint32_t i = 0; i < p->size; i++) {
+    reinterpret_cast<T *>(p->entries)[i].~T();
+  }
+  p->size = 0;
+  p->max_key = -1;
+  (p->emplace_back_vector_value(std::forward<Args>(args)), ...);
+  return *this;
+}
+
 template<class T>
 array<T> &array<T>::operator=(const array &other) noexcept {
   auto other_copy = other.p->ref_copy();
@@ -1438,6 +1457,12 @@ const T array<T>::get_value(const string &string_key, int64_t precomputed_hash)
   return value ? *value : T{};
 }
 
+template<class T>
+const T array<T>::get_list_value(int64_t int_key) const {
+  auto *value = p->find_vector_value(int_key);
+  return value ? *value : T{};
+}
+
 template<class T>
 template<class K>
 bool array<T>::has_key(const K &key) const {
@@ -228,6 +228,10 @@ public:
   template<class... Args>
   inline static array create(Args &&... args) __attribute__ ((always_inline));
 
+  // same as *this = create(args...), but reuses the buffer if it's not shared and big enough
+  template<class... Args>
+  inline array &refill_vector(Args &&... args) __attribute__ ((always_inline));
+
   inline array &operator=(const array &other) noexcept __attribute__ ((always_inline));
 
   inline array &operator=(array &&other) noexcept __attribute__ ((always_inline));
@@ -326,6 +330,8 @@ public:
   template<class K>
   const T get_value(const K &key) const;
   const T get_value(const string &string_key, int64_t precomputed_hash) const;
+  // the array must be a vector (a list var, see InferListArraysPass), so the is_vector() check is omitted
+  const T get_list_value(int64_t int_key) const;
 
   template<class ...Args>
   T &emplace_back(Args &&... args) noexcept;
@@ -5,9 +5,7 @@
 #include "runtime/array_functions.h"
 
 template<class FN>
-void walk_parts(const char *d, int64_t d_len, const string &str, int64_t limit, FN handle_part) {
-  const char *s = str.c_str();
-  int64_t s_len = str.size();
+void walk_parts(const char *d, int64_t d_len, const char *s, int64_t s_len, int64_t limit, FN handle_part) {
   int64_t prev = 0;
 
   if (d_len == 1) {
@@ -33,7 +31,8 @@ void walk_parts(const char *d, int64_t d_len, const string &str, int64_t limit,
   }
 
   if (limit > 1) {
-    for (int64_t i = 0; i < s_len;) {
+    // s may be a view into a longer string (see f$_explode_nth), a delimiter must not be matched past its end
+    for (int64_t i = 0; i + d_len <= s_len;) {
       int64_t j = 0;
       for (j = 0; j < d_len && d[j] == s[i + j]; j++) {
       }
@@ -53,21 +52,47 @@ void walk_parts(const char *d, int64_t d_len, const string &str, int64_t limit,
   handle_part(s + prev, static_cast<string::size_type>(s_len - prev));
 }
 
-string f$_explode_nth(const string &delimiter, const string &str, int64_t index) {
+template<class FN>
+void walk_parts(const char *d, int64_t d_len, const string &str, int64_t limit, FN handle_part) {
+  walk_parts(d, d_len, str.c_str(), str.size(), limit, handle_part);
+}
+
+// the nth part is returned as a view into s, it's materialized only if the caller needs a real string
+static tmp_string explode_nth_impl(const string &delimiter, const char *s, string::size_type s_len, int64_t index) {
   if (delimiter.empty()) {
     php_warning("Empty delimiter in function explode");
     return {};
   }
   int result_index = 0;
-  string res;
-  walk_parts(delimiter.c_str(), delimiter.size(), str, index+2, [&](const char *s, string::size_type l) {
+  tmp_string res;
+  walk_parts(delimiter.c_str(), delimiter.size(), s, s_len, index+2, [&](const char *part, string::size_type l) {
     if (result_index++ == index) {
-      res = string(s, l);
+      res = tmp_string{part, l};
     }
   });
   return res;
 }
 
+string f$_explode_nth(const string &delimiter, const string &str, int64_t index) {
+  tmp_string res = explode_nth_impl(delimiter, str.c_str(), str.size(), index);
+  if (res.data == str.c_str() && res.size == str.size()) {
+    return str;
+  }
+  return materialize_tmp_string(res);
+}
+
+string f$_explode_nth(const string &delimiter, tmp_string str, int64_t index) {
+  return materialize_tmp_string(explode_nth_impl(delimiter, str.data, str.size, index));
+}
+
+tmp_string f$_tmp_explode_nth(const string &delimiter, const string &str, int64_t index) {
+  return explode_nth_impl(delimiter, str.c_str(), str.size(), index);
+}
+
+tmp_string f$_tmp_explode_nth(const string &delimiter, tmp_string str, int64_t index) {
+  return explode_nth_impl(delimiter, str.data, str.size, index);
+}
+
 string f$_explode_1(const string &delimiter, const string &str) {
   return f$_explode_nth(delimiter, str, 0);
 }
@@ -224,11 +249,6 @@ array<mixed> f$range(const mixed &from, const mixed &to, int64_t step) {
   return range_int(from.to_int(), to.to_int(), step);
 }
 
-template<>
-array<int64_t> f$array_diff(const array<int64_t> &a1, const array<int64_t> &a2) {
-  return array_diff_impl(a1, a2, [](int64_t val) { return val; });
-}
-
 string implode_string_vector(const string &s, const array<string> &a) {
   // we use a precondition here that array is not empty: count-1 is not negative, elems[0] is valid
   int64_t count = a.count();
@@ -257,3 +277,48 @@ string implode_string_vector(const string &s, const array<string> &a) {
   }
   return result.finish_append();
 }
+
+template<class Kernel>
+static array<double> vk_array_element_wise(const array<double> &a, const array<double> &b, const char *function, Kernel kernel) {
+  if (a.count() != b.count()) {
+    php_warning("Arrays of different sizes (%" PRIi64 " and %" PRIi64 ") specified to function %s", a.count(), b.count(), function);
+    return {};
+  }
+  if (!a.is_vector() || !b.is_vector()) {
+    return vk_array_element_wise(f$array_values(a), f$array_values(b), function, kernel);
+  }
+  const int64_t size = a.count();
+  if (size == 0) {
+    return {};
+  }
+  array<double> result(array_size(size, true));
+  result.fill_vector(size, 0.0);
+  kernel(a.get_const_vector_pointer(), b.get_const_vector_pointer(), result.get_vector_pointer(), size);
+  return result;
+}
+
+array<double> f$vk_array_add(const array<double> &a, const array<double> &b) {
+  return vk_array_element_wise(a, b, "vk_array_add", simd_add);
+}
+
+array<double> f$vk_array_sub(const array<double> &a, const array<double> &b) {
+  return vk_array_element_wise(a, b, "vk_array_sub", simd_sub);
+}
+
+array<double> f$vk_array_mul(const array<double> &a, const array<double> &b) {
+  return vk_array_element_wise(a, b, "vk_array_mul", simd_mul);
+}
+
+array<double> f$vk_array_scale(const array<double> &a, double k) {
+  if (!a.is_vector()) {
+    return f$vk_array_scale(f$array_values(a), k);
+  }
+  const int64_t size = a.count();
+  if (size == 0) {
+    return {};
+  }
+  array<double> result(array_size(size, true));
+  result.fill_vector(size, 0.0);
+  simd_scale(a.get_const_vector_pointer(), k, result.get_vector_pointer(), size);
+  return result;
+}
@@ -7,6 +7,7 @@
 #include <climits>
 #include <numeric>
 
+#include "common/algorithms/simd-numeric.h"
 #include "common/type_traits/function_traits.h"
 #include "common/vector-product.h"
 
@@ -25,6 +26,9 @@ array<string> explode(char delimiter, const string &str, int64_t limit = std::nu
 
 array<string> f$explode(const string &delimiter, const string &str, int64_t limit = std::numeric_limits<int64_t>::max());
 string f$_explode_nth(const string &delimiter, const string &str, int64_t index);
+string f$_explode_nth(const string &delimiter, tmp_string str, int64_t index);
+tmp_string f$_tmp_explode_nth(const string &delimiter, const string &str, int64_t index);
+tmp_string f$_tmp_explode_nth(const string &delimiter, tmp_string str, int64_t index);
 string f$_explode_1(const string &delimiter, const string &str);
 std::tuple<string, string> f$_explode_tuple2(const string &delimiter, const string &str, int64_t mask, int64_t limit = 2+1);
 std::tuple<string, string, string> f$_explode_tuple3(const string &delimiter, const string &str, int64_t mask, int64_t limit = 3+1);
@@ -812,17 +816,47 @@ array<T> f$array_intersect_key(const array<T> &a1, const array<T1> &a2) {
   return result;
 }
 
+// array_intersect(), array_diff(), array_unique() and array_count_values() compare values as strings: (string)$a === (string)$b;
+// instead of converting every value with f$strval(), it's used as a key of a hash set (an array) as is whenever possible:
+// an int and a numeric string are the same key in an array, exactly when their string representations are equal
+inline int64_t array_value_as_string_key(int64_t value) noexcept {
+  return value;
+}
+
+inline const string &array_value_as_string_key(const string &value) noexcept {
+  return value;
+}
+
+inline mixed array_value_as_string_key(const mixed &value) noexcept {
+  switch (value.get_type()) {
+    case mixed::type::INTEGER:
+    case mixed::type::STRING:
+      return value;
+    case mixed::type::NUL:
+      return string{};
+    case mixed::type::BOOLEAN:
+      return value.as_bool() ? mixed{int64_t{1}} : mixed{string{}};
+    default:
+      return f$strval(value);
+  }
+}
+
+template<class T>
+string array_value_as_string_key(const T &value) {
+  return f$strval(value);
+}
+
 template<class T, class T1>
 array<T> f$array_intersect(const array<T> &a1, const array<T1> &a2) {
   array<T> result(a1.size().min(a2.size()));
 
   array<int64_t> values(array_size(a2.count(), false));
   for (const auto &it : a2) {
-    values.set_value(f$strval(it.get_value()), 1);
+    values.set_value(array_value_as_string_key(it.get_value()), 1);
   }
 
   for (const auto &it : a1) {
-    if (values.has_key(f$strval(it.get_value()))) {
+    if (values.has_key(array_value_as_string_key(it.get_value()))) {
       result.set_value(it);
     }
   }
@@ -881,12 +915,9 @@ array<T> array_diff_impl(const array<T> &a1, const array<T1> &a2, const Proj &pr
 
 template<class T, class T1>
 array<T> f$array_diff(const array<T> &a1, const array<T1> &a2) {
-  return array_diff_impl(a1, a2, [](const auto &val) { return f$strval(val); });
+  return array_diff_impl(a1, a2, [](const auto &val) { return array_value_as_string_key(val); });
 }
 
-template<>
-array<int64_t> f$array_diff(const array<int64_t> &a1, const array<int64_t> &a2);
-
 template<class T, class T1, class T2>
 array<T> f$array_diff(const array<T> &a1, const array<T1> &a2, const array<T2> &a3) {
   return f$array_diff(f$array_diff(a1, a2), a3);
@@ -1067,10 +1098,10 @@ array<T> f$array_unique(const array<T> &a, int64_t flags) {
       case SORT_NUMERIC:
         return values[f$intval(value)];
       case SORT_STRING:
-        return values[f$strval(value)];
+        return values[array_value_as_string_key(value)];
       default:
         php_warning("Unsupported flags in function array_unique");
-        return values[f$strval(value)];
+        return values[array_value_as_string_key(value)];
     }
   };
 
@@ -1090,7 +1121,7 @@ array<int64_t> f$array_count_values(const array<T> &a) {
   array<int64_t> result(array_size(a.count(), false));
 
   for (const auto &it : a) {
-    ++result[f$strval(it.get_value())];
+    ++result[array_value_as_string_key(it.get_value())];
   }
   return result;
 }
@@ -1489,6 +1520,12 @@ template<class T, class ReturnT>
 ReturnT f$array_sum(const array<T> &a) {
   static_assert(!std::is_same_v<T, int>, "int is forbidden");
 
+  if constexpr (std::is_same_v<T, int64_t> || std::is_same_v<T, double>) {
+    if (a.is_vector()) {
+      return simd_sum(a.get_const_vector_pointer(), a.count());
+    }
+  }
+
   ReturnT result = 0;
   for (const auto &it : a) {
     if constexpr (std::is_same_v<T, int64_t>) {
@@ -1587,7 +1624,7 @@ inline int64_t vk_dot_product_dense<int64_t>(const array<int64_t> &a, const arra
   const int64_t size = min(a.count(), b.count());
   const int64_t *ap = a.get_const_vector_pointer();
   const int64_t *bp = b.get_const_vector_pointer();
-  return std::inner_product(ap, ap + size, bp, 0L);
+  return simd_dot_product(ap, bp, size);
 }
 
 
@@ -1607,3 +1644,9 @@ T f$vk_dot_product(const array<T> &a, const array<T> &b) {
   }
   return vk_dot_product_sparse<T>(a, b);
 }
+
+// element-wise vector math: the arrays are treated as lists of the same size, the keys are ignored
+array<double> f$vk_array_add(const array<double> &a, const array<double> &b);
+array<double> f$vk_array_sub(const array<double> &a, const array<double> &b);
+array<double> f$vk_array_mul(const array<double> &a, const array<double> &b);
+array<double> f$vk_array_scale(const array<double> &a, double k);
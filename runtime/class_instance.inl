@@ -98,3 +98,12 @@ void class_instance<T>::force_destroy(ExtraRefCnt expected_ref_cnt) noexcept {
     destroy();
   }
 }
+
+// a devirtualized call $obj->f() is compiled into a direct call, bypassing the dispatcher with its null check
+template<class I>
+I &&check_not_null_receiver(I &&instance, const char *method_name) noexcept {
+  if (unlikely(instance.is_null())) {
+    php_critical_error("call method(%s) on null object", method_name);
+  }
+  return std::forward<I>(instance);
+}
@@ -4,13 +4,155 @@
 
 #include "runtime/confdata-functions.h"
 
+#include <sys/mman.h>
+
 #include "common/algorithms/contains.h"
 
+#include "runtime/allocator.h"
 #include "runtime/confdata-global-manager.h"
 #include "runtime/string_functions.h"
 
 namespace {
 
+// Keeps the results of the wildcard lookups, which are built by scanning the confdata, while the sample stays the same.
+// The confdata shared memory is allocated by the master only, so each worker keeps the results in its own memory.
+// The results are marked as the confdata constants, scripts get them without copying.
+// When the cache memory is over, the cached results are kept, and new ones are returned uncached until the sample changes:
+// clearing the full cache would make every request rebuild the same results and fill it up again.
+class ConfdataWildcardCache : vk::not_copyable {
+public:
+  // it must be called at the beginning of a request, when the previously returned arrays are not referenced anymore
+  void on_sample_acquired(uint64_t sample_generation) noexcept {
+    if (sample_generation_ != sample_generation) {
+      clear();
+      sample_generation_ = sample_generation;
+    }
+  }
+
+  const array<mixed> *find(const string &wildcard) const noexcept {
+    if (!storage_) {
+      return nullptr;
+    }
+    const auto it = storage_->find(wildcard);
+    return it != storage_->end() ? &it->second : nullptr;
+  }
+
+  // returns the cached copy of the result, or the result itself if it doesn't fit into the cache
+  array<mixed> store(const string &wildcard, const array<mixed> &result) noexcept {
+    if (is_full_ || !(storage_ || init())) {
+      return result;
+    }
+
+    dl::MemoryReplacementGuard cache_memory_guard{resource_};
+    string cached_wildcard;
+    array<mixed> cached_result;
+    if (!copy_string(wildcard, cached_wildcard) || !copy_array(result, cached_result) ||
+        !resource_.is_enough_memory_for(STORAGE_NODE_SIZE)) {
+      // nothing is cached anymore, until the next sample is acquired
+      is_full_ = true;
+      return result;
+    }
+    mark_string_as_confdata_const(cached_wildcard);
+    mark_array_as_confdata_const(cached_result);
+    storage_->emplace(cached_wildcard, cached_result);
+    return cached_result;
+  }
+
+private:
+  using wildcard_results_storage = memory_resource::stl::map<string, array<mixed>, memory_resource::unsynchronized_pool_resource, stl_string_less>;
+
+  static constexpr size_t CACHE_MEMORY_SIZE = 8 * 1024 * 1024;
+  // the red-black tree node: the value and 3 pointers with the color
+  static constexpr size_t STORAGE_NODE_SIZE = sizeof(wildcard_results_storage::value_type) + 4 * sizeof(void *);
+
+  bool init() noexcept {
+    if (init_failed_) {
+      return false;
+    }
+    // the pages are committed lazily, only the used part of the cache takes the memory
+    void *mem = mmap(nullptr, CACHE_MEMORY_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem == MAP_FAILED) {
+      init_failed_ = true;
+      return false;
+    }
+    resource_.init(mem, CACHE_MEMORY_SIZE);
+    create_storage();
+    return true;
+  }
+
+  void clear() noexcept {
+    if (storage_) {
+      // all the cached values are allocated in the cache memory, so there is no need to destroy them one by one
+      resource_.hard_reset();
+      create_storage();
+    }
+    is_full_ = false;
+  }
+
+  void create_storage() noexcept {
+    void *mem = resource_.allocate(sizeof(*storage_));
+    php_assert(mem);
+    storage_ = new(mem) wildcard_results_storage{wildcard_results_storage::allocator_type{resource_}};
+  }
+
+  bool copy_string(const string &src, string &dst) noexcept {
+    if (!resource_.is_enough_memory_for(string::estimate_memory_usage(src.size()))) {
+      return false;
+    }
+    dst = string{src.c_str(), src.size()};
+    return true;
+  }
+
+  // the keys are copied, the values are confdata constants, they are shared
+  bool copy_array(const array<mixed> &src, array<mixed> &dst) noexcept {
+    if (src.empty()) {
+      dst = array<mixed>{};
+      return true;
+    }
+    if (!resource_.is_enough_memory_for(src.calculate_memory_for_copying())) {
+      return false;
+    }
+    dst = array<mixed>{src.size()};
+    for (const auto &it : src) {
+      if (it.is_string_key()) {
+        string key;
+        if (!copy_string(it.get_string_key(), key)) {
+          return false;
+        }
+        dst.set_value(key, it.get_value());
+      } else {
+        dst.set_value(it.get_int_key(), it.get_value());
+      }
+    }
+    return true;
+  }
+
+  static void mark_string_as_confdata_const(string &str) noexcept {
+    if (!str.is_reference_counter(ExtraRefCnt::for_global_const)) {
+      str.set_reference_counter_to(ExtraRefCnt::for_confdata);
+    }
+  }
+
+  static void mark_array_as_confdata_const(array<mixed> &arr) noexcept {
+    if (arr.is_reference_counter(ExtraRefCnt::for_global_const)) {
+      return;
+    }
+    arr.set_reference_counter_to(ExtraRefCnt::for_confdata);
+    const auto last = arr.end_no_mutate();
+    for (auto it = arr.begin_no_mutate(); it != last; ++it) {
+      if (it.is_string_key()) {
+        mark_string_as_confdata_const(it.get_string_key());
+      }
+    }
+  }
+
+  memory_resource::unsynchronized_pool_resource resource_;
+  wildcard_results_storage *storage_{nullptr};
+  uint64_t sample_generation_{0};
+  bool is_full_{false};
+  bool init_failed_{false};
+};
+
 class ConfdataLocalManager : vk::not_copyable {
 public:
   static ConfdataLocalManager &get() {
@@ -21,6 +163,7 @@ public:
   void acquire_sample() noexcept {
     php_assert(!acquired_sample_);
     acquired_sample_ = global_manager_.acquire_current_sample();
+    wildcard_cache_.on_sample_acquired(acquired_sample_->get_generation());
   }
 
   void release_sample() noexcept {
@@ -46,12 +189,17 @@ public:
     return global_manager_.get_key_blacklist();
   }
 
+  ConfdataWildcardCache &get_wildcard_cache() noexcept {
+    return wildcard_cache_;
+  }
+
 private:
   ConfdataLocalManager() :
     global_manager_{ConfdataGlobalManager::get()} {};
 
   ConfdataGlobalManager &global_manager_;
   const ConfdataSample *acquired_sample_{nullptr};
+  ConfdataWildcardCache wildcard_cache_;
 };
 
 bool verify_confdata_key_param(const string &param, const char *real_name) noexcept {
@@ -116,11 +264,9 @@ mixed f$confdata_get_value(const string &key) noexcept {
   return {};
 }
 
-array<mixed> f$confdata_get_values_by_any_wildcard(const string &wildcard) noexcept {
-  if (unlikely(!verify_confdata_key_param(wildcard, "wildcard"))) {
-    return {};
-  }
+namespace {
 
+array<mixed> confdata_get_values_by_any_wildcard_impl(const string &wildcard) noexcept {
   const auto &local_manager = ConfdataLocalManager::get();
   const auto &predefined_wildcards = local_manager.get_predefined_wildcards();
   ConfdataKeyMaker key_maker;
@@ -197,6 +343,25 @@ array<mixed> f$confdata_get_values_by_any_wildcard(const string &wildcard) noexc
   return result;
 }
 
+} // namespace
+
+array<mixed> f$confdata_get_values_by_any_wildcard(const string &wildcard) noexcept {
+  if (unlikely(!verify_confdata_key_param(wildcard, "wildcard"))) {
+    return {};
+  }
+
+  auto &wildcard_cache = ConfdataLocalManager::get().get_wildcard_cache();
+  if (const auto *cached_result = wildcard_cache.find(wildcard)) {
+    return *cached_result;
+  }
+  array<mixed> result = confdata_get_values_by_any_wildcard_impl(wildcard);
+  // the entire prefix arrays are returned from the confdata as they are
+  if (result.is_reference_counter(ExtraRefCnt::for_confdata)) {
+    return result;
+  }
+  return wildcard_cache.store(wildcard, result);
+}
+
 array<mixed> f$confdata_get_values_by_predefined_wildcard(const string &wildcard) noexcept {
   if (unlikely(!verify_confdata_key_param(wildcard, "wildcard"))) {
     return {};
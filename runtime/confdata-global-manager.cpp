@@ -9,6 +9,9 @@
 
 namespace {
 
+// samples are reset only by the master process
+uint64_t last_sample_generation = 0;
+
 void recursively_destroy_confdata_element(mixed &element) noexcept {
   if (element.is_reference_counter(ExtraRefCnt::for_global_const)) {
     return;
@@ -39,11 +42,16 @@ void ConfdataSample::init(memory_resource::unsynchronized_pool_resource &resourc
   auto *mem = resource_->allocate(sizeof(*confdata_storage_));
   php_assert(mem);
   confdata_storage_ = new(mem) confdata_sample_storage{confdata_sample_storage::allocator_type{*resource_}};
+  // the generation is placed in the shared memory so that workers see it after a sample switch
+  generation_ = static_cast<uint64_t *>(resource_->allocate(sizeof(*generation_)));
+  php_assert(generation_);
+  *generation_ = 0;
 }
 
 void ConfdataSample::reset(confdata_sample_storage &&new_confdata) noexcept {
   clear();
   *confdata_storage_ = std::move(new_confdata);
+  *generation_ = ++last_sample_generation;
 }
 
 void ConfdataSample::clear() noexcept {
@@ -74,8 +82,10 @@ void ConfdataSample::destroy() noexcept {
     clear();
     confdata_storage_->~map();
     resource_->deallocate(confdata_storage_, sizeof(*confdata_storage_));
+    resource_->deallocate(generation_, sizeof(*generation_));
 
     confdata_storage_ = nullptr;
+    generation_ = nullptr;
     resource_ = nullptr;
   }
 }
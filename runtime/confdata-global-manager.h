@@ -40,9 +40,15 @@ public:
     return *confdata_storage_;
   }
 
+  // unique for each reset, it lets workers detect that the sample content has changed
+  uint64_t get_generation() const noexcept {
+    return *generation_;
+  }
+
 private:
   memory_resource::unsynchronized_pool_resource *resource_{nullptr};
   confdata_sample_storage *confdata_storage_{nullptr};
+  uint64_t *generation_{nullptr};
   std::forward_list<ConfdataGarbageNode> *garbage_{nullptr};
 };
 
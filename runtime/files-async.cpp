@@ -0,0 +1,187 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#include "runtime/files-async.h"
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "runtime/array_functions.h"
+#include "runtime/critical_section.h"
+#include "runtime/files.h"
+#include "runtime/net_events.h"
+#include "runtime/resumable.h"
+#include "runtime/streams.h"
+#include "server/file-io-adaptor.h"
+#include "server/slot-ids-factory.h"
+
+namespace file_io_async {
+
+namespace {
+
+double script_file_io_wait_time = 0;
+
+// returns the path for the names served by the file stream wrapper (with or without the file:// prefix), nullptr otherwise
+const char *get_file_path(const string &name) noexcept {
+  constexpr const char file_wrapper_prefix[] = "file://";
+  constexpr size_t file_wrapper_prefix_len = sizeof(file_wrapper_prefix) - 1;
+  if (name.empty()) {
+    return nullptr;
+  }
+  if (!strncmp(name.c_str(), file_wrapper_prefix, file_wrapper_prefix_len)) {
+    return name.c_str() + file_wrapper_prefix_len;
+  }
+  return memmem(name.c_str(), name.size(), "://", 3) ? nullptr : name.c_str();
+}
+
+double get_wait_start_time() noexcept {
+  update_precise_now();
+  return get_precise_now();
+}
+
+void account_wait_time(double wait_start_time) noexcept {
+  update_precise_now();
+  const double wait_time = get_precise_now() - wait_start_time;
+  script_file_io_wait_time += wait_time;
+  add_running_fork_file_io_wait_time(wait_time);
+}
+
+class file_get_contents_concurrently final : public Resumable {
+private:
+  using ReturnT = Optional<string>;
+
+  std::unique_ptr<FileIoOperation> operation;
+  int resumable_id{0};
+  double wait_start_time{0};
+
+public:
+  explicit file_get_contents_concurrently(std::unique_ptr<FileIoOperation> &&operation) noexcept
+    : operation(std::move(operation)) {}
+
+  bool run() noexcept final {
+    RESUMABLE_BEGIN
+    wait_start_time = get_wait_start_time();
+    resumable_id = vk::singleton<FileIoAdaptor>::get().launch_operation_resumable(std::move(operation));
+    operation = f$wait<std::unique_ptr<FileIoOperation>, false>(resumable_id);
+    TRY_WAIT(file_get_contents_concurrently_label, operation, std::unique_ptr<FileIoOperation>);
+    account_wait_time(wait_start_time);
+    if (!operation || operation->processed < operation->size) {
+      RETURN(ReturnT{false});
+    }
+    string res(operation->buffer, static_cast<string::size_type>(operation->size));
+    operation.reset();
+    RETURN(res);
+    RESUMABLE_END
+  }
+};
+
+class file_put_contents_concurrently final : public Resumable {
+private:
+  using ReturnT = Optional<int64_t>;
+
+  const string name;
+  const size_t path_offset{0};
+  std::unique_ptr<FileIoOperation> operation;
+  int resumable_id{0};
+  double wait_start_time{0};
+
+public:
+  file_put_contents_concurrently(const string &name, size_t path_offset, std::unique_ptr<FileIoOperation> &&operation) noexcept
+    : name(name)
+    , path_offset(path_offset)
+    , operation(std::move(operation)) {}
+
+  bool run() noexcept final {
+    RESUMABLE_BEGIN
+    wait_start_time = get_wait_start_time();
+    resumable_id = vk::singleton<FileIoAdaptor>::get().launch_operation_resumable(std::move(operation));
+    operation = f$wait<std::unique_ptr<FileIoOperation>, false>(resumable_id);
+    TRY_WAIT(file_put_contents_concurrently_label, operation, std::unique_ptr<FileIoOperation>);
+    account_wait_time(wait_start_time);
+    if (!operation || operation->processed < operation->size) {
+      operation.reset();
+      dl::critical_section_call(unlink, name.c_str() + path_offset);
+      RETURN(ReturnT{false});
+    }
+    const int64_t written = operation->size;
+    operation.reset();
+    RETURN(written);
+    RESUMABLE_END
+  }
+};
+
+} // namespace
+
+} // namespace file_io_async
+
+Optional<string> f$file_get_contents_concurrently(const string &name) {
+  using namespace file_io_async;
+  const char *path = get_file_path(name);
+  if (path == nullptr || !vk::singleton<FileIoAdaptor>::get().is_available()) {
+    return f$file_get_contents(name);
+  }
+
+  struct stat stat_buf{};
+  dl::CriticalSectionSmartGuard critical_section;
+  const int file_fd = open_safe(path, O_RDONLY);
+  if (file_fd < 0) {
+    return false;
+  }
+  if (fstat(file_fd, &stat_buf) < 0) {
+    close_safe(file_fd);
+    return false;
+  }
+  if (!S_ISREG(stat_buf.st_mode)) {
+    php_warning("Regular file expected as first argument in function file_get_contents_concurrently, \"%s\" is given", name.c_str());
+    close_safe(file_fd);
+    return false;
+  }
+  const size_t size = stat_buf.st_size;
+  if (size > string::max_size()) {
+    php_warning("File \"%s\" is too large to get its content", name.c_str());
+    close_safe(file_fd);
+    return false;
+  }
+  auto operation = std::make_unique<FileIoOperation>(FileIoOperation::Type::read, file_io_requests_factory.create_slot(), file_fd, size);
+  critical_section.leave_critical_section();
+
+  return start_resumable<Optional<string>>(new file_get_contents_concurrently(std::move(operation)));
+}
+
+Optional<int64_t> f$file_put_contents_concurrently(const string &name, const mixed &content_var, int64_t flags) {
+  using namespace file_io_async;
+  const char *path = get_file_path(name);
+  if (path == nullptr || !vk::singleton<FileIoAdaptor>::get().is_available()) {
+    return f$file_put_contents(name, content_var, flags);
+  }
+
+  const string content = content_var.is_array() ? f$implode(string(), content_var.to_array()) : content_var.to_string();
+  if (flags & ~FILE_APPEND) {
+    php_warning("Flags other, than FILE_APPEND are not supported in file_put_contents_concurrently");
+    flags &= FILE_APPEND;
+  }
+
+  dl::CriticalSectionSmartGuard critical_section;
+  const int append_flag = (flags & FILE_APPEND) ? O_APPEND : O_TRUNC;
+  const int file_fd = open(path, O_WRONLY | O_CREAT | append_flag, 0644);
+  if (file_fd < 0) {
+    php_warning("Can't open file \"%s\"", name.c_str());
+    return false;
+  }
+  auto operation = std::make_unique<FileIoOperation>(FileIoOperation::Type::write, file_io_requests_factory.create_slot(), file_fd, content.size());
+  memcpy(operation->buffer, content.c_str(), content.size());
+  critical_section.leave_critical_section();
+
+  return start_resumable<Optional<int64_t>>(new file_put_contents_concurrently(name, path - name.c_str(), std::move(operation)));
+}
+
+double f$get_file_io_wait_time() {
+  return file_io_async::script_file_io_wait_time;
+}
+
+void free_files_async_lib() {
+  file_io_async::script_file_io_wait_time = 0;
+}
@@ -0,0 +1,17 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#pragma once
+
+#include "runtime/kphp_core.h"
+
+// the file content is read or written by the I/O threads, while the other forks keep running;
+// opening the file is still done synchronously, the streams other than file:// fall back to the synchronous functions
+Optional<string> f$file_get_contents_concurrently(const string &name);
+Optional<int64_t> f$file_put_contents_concurrently(const string &name, const mixed &content_var, int64_t flags = 0);
+
+// the total time the script waited for the concurrent file operations
+double f$get_file_io_wait_time();
+
+void free_files_async_lib();
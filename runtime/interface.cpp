@@ -30,6 +30,7 @@
 #include "runtime/datetime/timelib_wrapper.h"
 #include "runtime/exception.h"
 #include "runtime/files.h"
+#include "runtime/files-async.h"
 #include "runtime/instance-cache.h"
 #include "runtime/job-workers/client-functions.h"
 #include "runtime/job-workers/server-functions.h"
@@ -58,6 +59,7 @@
 #include "runtime/url.h"
 #include "runtime/zlib.h"
 #include "server/curl-adaptor.h"
+#include "server/file-io-adaptor.h"
 #include "server/database-drivers/adaptor.h"
 #include "server/database-drivers/mysql/mysql.h"
 #include "server/database-drivers/pgsql/pgsql.h"
@@ -2412,6 +2414,8 @@ static void free_runtime_libs() {
 #endif
   vk::singleton<database_drivers::Adaptor>::get().reset();
   vk::singleton<curl_async::CurlAdaptor>::get().reset();
+  vk::singleton<file_io_async::FileIoAdaptor>::get().reset();
+  free_files_async_lib();
   vk::singleton<OomHandler>::get().reset();
   free_interface_lib();
   hard_reset_var(JsonEncoderError::msg);
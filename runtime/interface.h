@@ -243,6 +243,14 @@ inline void f$kphp_turn_on_host_tag_in_inner_statshouse_metrics_toggle() {
   StatsHouseManager::get().turn_on_host_tag_toggle();
 }
 
+inline void f$statshouse_write_count(const string &name, const array<string> &tags, double count = 1.0) {
+  StatsHouseManager::get().add_application_metric_count(name, tags, count);
+}
+
+inline void f$statshouse_write_value(const string &name, const array<string> &tags, double value) {
+  StatsHouseManager::get().add_application_metric_value(name, tags, value);
+}
+
 template <typename F>
 inline void f$kphp_extended_instance_cache_metrics_init(F &&callback) {
   dl::CriticalSectionGuard guard;
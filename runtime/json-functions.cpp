@@ -5,6 +5,7 @@
 #include "runtime/json-functions.h"
 
 #include "common/algorithms/find.h"
+#include "common/algorithms/number-conversions.h"
 
 #include "runtime/exception.h"
 #include "runtime/string_functions.h"
@@ -544,8 +545,15 @@ bool do_json_decode(const char *s, int s_len, int &i, mixed &v, const char *json
           return true;
         }
 
+        double floatval = 0;
+        if (try_parse_simple_decimal(s + i, j - i, &floatval)) {
+          i = j;
+          new(&v) mixed(floatval);
+          return true;
+        }
+
         char *end_ptr;
-        double floatval = strtod(s + i, &end_ptr);
+        floatval = strtod(s + i, &end_ptr);
         if (end_ptr == s + j) {
           i = j;
           new(&v) mixed(floatval);
@@ -4,6 +4,7 @@
 
 #include "runtime/mbstring.h"
 
+#include "common/algorithms/simd-utf8.h"
 #include "common/unicode/unicode-utils.h"
 #include "common/unicode/utf8-utils.h"
 
@@ -53,43 +54,11 @@ static int mb_detect_encoding(const string &encoding) {
   return -1;
 }
 
-static int64_t mb_UTF8_strlen(const char *s) {
-  int64_t res = 0;
-  for (int64_t i = 0; s[i]; i++) {
-    if ((((unsigned char)s[i]) & 0xc0) != 0x80) {
-      res++;
-    }
-  }
-  return res;
-}
-
-static int64_t mb_UTF8_advance(const char *s, int64_t cnt) {
-  php_assert (cnt >= 0);
-  int64_t i;
-  for (i = 0; s[i] && cnt >= 0; i++) {
-    if ((((unsigned char)s[i]) & 0xc0) != 0x80) {
-      cnt--;
-    }
-  }
-  if (cnt < 0) {
-    i--;
-  }
-  return i;
-}
-
-static int64_t mb_UTF8_get_offset(const char *s, int64_t pos) {
-  int64_t res = 0;
-  for (int64_t i = 0; i < pos && s[i]; i++) {
-    if ((((unsigned char)s[i]) & 0xc0) != 0x80) {
-      res++;
-    }
-  }
-  return res;
-}
-
-bool mb_UTF8_check(const char *s) {
+bool mb_UTF8_check(const char *s, size_t len) {
+  const char *end = s + len;
   do {
 #define CHECK(condition) if (!(condition)) {return false;}
+    s += utf8_ascii_prefix_length(s, end - s);
     unsigned int a = (unsigned char)(*s++);
     if ((a & 0x80) == 0) {
       if (a == 0) {
@@ -141,7 +110,7 @@ bool f$mb_check_encoding(const string &str, const string &encoding) {
     return true;
   }
 
-  return mb_UTF8_check(str.c_str());
+  return mb_UTF8_check(str.c_str(), str.size());
 }
 
 
@@ -156,7 +125,7 @@ int64_t f$mb_strlen(const string &str, const string &encoding) {
     return str.size();
   }
 
-  return mb_UTF8_strlen(str.c_str());
+  return utf8_count_code_points(str.c_str(), str.size());
 }
 
 
@@ -212,7 +181,16 @@ string f$mb_strtolower(const string &str, const string &encoding) {
     int res_len = 0;
     int p;
     int ch;
-    while ((p = get_char_utf8(&ch, s)) > 0) {
+    while (true) {
+      const size_t ascii_len = utf8_ascii_prefix_length(s, str.c_str() + len - s);
+      for (size_t i = 0; i < ascii_len; i++) {
+        res[res_len + i] = 'A' <= s[i] && s[i] <= 'Z' ? static_cast<char>(s[i] + 'a' - 'A') : s[i];
+      }
+      s += ascii_len;
+      res_len += ascii_len;
+      if ((p = get_char_utf8(&ch, s)) <= 0) {
+        break;
+      }
       s += p;
       res_len += put_char_utf8(unicode_tolower(ch), &res[res_len]);
     }
@@ -282,7 +260,16 @@ string f$mb_strtoupper(const string &str, const string &encoding) {
     int res_len = 0;
     int p;
     int ch;
-    while ((p = get_char_utf8(&ch, s)) > 0) {
+    while (true) {
+      const size_t ascii_len = utf8_ascii_prefix_length(s, str.c_str() + len - s);
+      for (size_t i = 0; i < ascii_len; i++) {
+        res[res_len + i] = 'a' <= s[i] && s[i] <= 'z' ? static_cast<char>(s[i] + 'A' - 'a') : s[i];
+      }
+      s += ascii_len;
+      res_len += ascii_len;
+      if ((p = get_char_utf8(&ch, s)) <= 0) {
+        break;
+      }
       s += p;
       res_len += put_char_utf8(unicode_toupper(ch), &res[res_len]);
     }
@@ -320,12 +307,12 @@ Optional<int64_t> mp_strpos_impl(const string &haystack, const string &needle, i
     return f$strpos(haystack, needle, offset);
   }
 
-  int64_t UTF8_offset = mb_UTF8_advance(haystack.c_str(), offset);
+  int64_t UTF8_offset = utf8_advance(haystack.c_str(), haystack.size(), offset);
   const char *s = static_cast<const char *>(memmem(haystack.c_str() + UTF8_offset, haystack.size() - UTF8_offset, needle.c_str(), needle.size()));
   if (unlikely(s == nullptr)) {
     return false;
   }
-  return mb_UTF8_get_offset(haystack.c_str() + UTF8_offset, s - (haystack.c_str() + UTF8_offset)) + offset;
+  return utf8_count_code_points(haystack.c_str() + UTF8_offset, s - (haystack.c_str() + UTF8_offset)) + offset;
 }
 
 } // namespace
@@ -366,7 +353,7 @@ string f$mb_substr(const string &str, int64_t start, const mixed &length_var, co
     return res.val();
   }
 
-  int64_t len = mb_UTF8_strlen(str.c_str());
+  int64_t len = utf8_count_code_points(str.c_str(), str.size());
   if (start < 0) {
     start += len;
   }
@@ -383,8 +370,8 @@ string f$mb_substr(const string &str, int64_t start, const mixed &length_var, co
     length = len - start;
   }
 
-  int64_t UTF8_start = mb_UTF8_advance(str.c_str(), start);
-  int64_t UTF8_length = mb_UTF8_advance(str.c_str() + UTF8_start, length);
+  int64_t UTF8_start = utf8_advance(str.c_str(), str.size(), start);
+  int64_t UTF8_length = utf8_advance(str.c_str() + UTF8_start, str.size() - UTF8_start, length);
 
   return {str.c_str() + UTF8_start, static_cast<string::size_type>(UTF8_length)};
 }
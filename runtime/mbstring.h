@@ -9,7 +9,7 @@
 #include "runtime/kphp_core.h"
 #include "runtime/string_functions.h"
 
-bool mb_UTF8_check(const char *s);
+bool mb_UTF8_check(const char *s, size_t len);
 
 bool f$mb_check_encoding(const string &str, const string &encoding = CP1251);
 
@@ -14,6 +14,7 @@
 #include "server/curl-adaptor.h"
 #include "server/database-drivers/adaptor.h"
 #include "server/database-drivers/response.h"
+#include "server/file-io-adaptor.h"
 #include "server/php-queries.h"
 
 int timeout_convert_to_ms(double timeout) {
@@ -61,6 +62,10 @@ bool process_net_event(net_event_t *e) {
      [&](curl_async::CurlResponse *response) {
          php_assert(e->slot_id == response->bound_request_id);
          vk::singleton<curl_async::CurlAdaptor>::get().process_response_event(std::unique_ptr<curl_async::CurlResponse>(response));
+     },
+     [&](file_io_async::FileIoOperation *operation) {
+         php_assert(e->slot_id == operation->request_id);
+         vk::singleton<file_io_async::FileIoAdaptor>::get().process_response_event(std::unique_ptr<file_io_async::FileIoOperation>(operation));
      }
     }, e->data);
 
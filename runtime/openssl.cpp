@@ -21,7 +21,9 @@
 #include <sys/time.h>
 #include <unistd.h>
 
+#include "common/algorithms/xxh3.h"
 #include "common/crc32.h"
+#include "common/crypto/multi-buffer-hashes.h"
 #include "common/resolver.h"
 #include "common/smart_ptrs/unique_ptr_with_delete_function.h"
 #include "common/wrappers/openssl.h"
@@ -71,6 +73,9 @@ public:
   }
 
   string hash_hmac(const string &data, const string &key, bool raw_output) const noexcept {
+    if (!get_evp) {
+      php_critical_error ("algo %s not supported in function hash_hmac", name);
+    }
     return call_hash_algo(raw_output, [this, &data, &key](string &out) {
       unsigned int md_len = 0;
       dl::critical_section_call(HMAC, get_evp(), key.c_str(), static_cast<int>(key.size()),
@@ -89,6 +94,13 @@ HashTraits make_md5_traits() noexcept {
   return HashTraits{"md5", MD5, MD5_DIGEST_LENGTH, EVP_md5};
 }
 
+// like php, the hash is printed as a big-endian number
+unsigned char *xxh3_digest(const unsigned char *data, size_t len, unsigned char *digest) noexcept {
+  const uint64_t hash = __builtin_bswap64(xxh3_64(data, len));
+  memcpy(digest, &hash, sizeof(hash));
+  return digest;
+}
+
 const auto &get_supported_hash_algorithms() noexcept {
   const static auto supported_algorithms = vk::to_array<HashTraits>(
     {
@@ -97,7 +109,8 @@ const auto &get_supported_hash_algorithms() noexcept {
       HashTraits{"sha256", SHA256, SHA256_DIGEST_LENGTH, EVP_sha256},
       HashTraits{"sha384", SHA384, SHA384_DIGEST_LENGTH, EVP_sha384},
       HashTraits{"sha512", SHA512, SHA512_DIGEST_LENGTH, EVP_sha512},
-      make_md5_traits()
+      make_md5_traits(),
+      HashTraits{"xxh3", xxh3_digest, sizeof(uint64_t), nullptr} // not a cryptographic hash, so there is no hmac
     });
   return supported_algorithms;
 }
@@ -124,7 +137,14 @@ array<string> f$hash_algos() noexcept {
 }
 
 array<string> f$hash_hmac_algos() noexcept {
-  return f$hash_algos();
+  const auto &supported_algorithms = get_supported_hash_algorithms();
+  array<string> result{array_size{static_cast<int64_t>(supported_algorithms.size()), true}};
+  for (const auto &algo : supported_algorithms) {
+    if (algo.get_evp) {
+      result.emplace_back(string{algo.name});
+    }
+  }
+  return result;
 }
 
 string f$hash(const string &algo, const string &s, bool raw_output) noexcept {
@@ -143,6 +163,76 @@ string f$md5(const string &s, bool raw_output) noexcept {
   return make_md5_traits().hash(s, raw_output);
 }
 
+namespace {
+
+string digest_to_string(const uint8_t *digest, size_t digest_len, bool raw_output) noexcept {
+  if (raw_output) {
+    return string{reinterpret_cast<const char *>(digest), static_cast<string::size_type>(digest_len)};
+  }
+  string res{static_cast<string::size_type>(digest_len * 2), false};
+  for (size_t i = 0; i < digest_len; i++) {
+    res[2 * i] = lhex_digits[(digest[i] >> 4) & 15];
+    res[2 * i + 1] = lhex_digits[digest[i] & 15];
+  }
+  return res;
+}
+
+// the strings are hashed by chunks, so that the multi-buffer code always has enough messages for all its lanes
+// and the temporary buffers fit on the stack
+template<size_t DIGEST_SIZE, class MultiBufferHash>
+array<string> hash_batch(const array<string> &strs, bool raw_output, const MultiBufferHash &multi_buffer_hash) noexcept {
+  constexpr size_t CHUNK_SIZE = 64;
+  array<string> result{strs.size()};
+
+  const uint8_t *inputs[CHUNK_SIZE];
+  size_t lens[CHUNK_SIZE];
+  uint8_t digests[CHUNK_SIZE][DIGEST_SIZE];
+  array<string>::const_iterator chunk_begin = strs.begin();
+  size_t chunk_size = 0;
+  auto flush_chunk = [&] {
+    multi_buffer_hash(inputs, lens, chunk_size, digests);
+    for (size_t i = 0; i < chunk_size; ++i, ++chunk_begin) {
+      result.set_value(chunk_begin.get_key(), digest_to_string(digests[i], DIGEST_SIZE, raw_output));
+    }
+    chunk_size = 0;
+  };
+
+  for (const auto &it : strs) {
+    const string &s = it.get_value();
+    inputs[chunk_size] = reinterpret_cast<const uint8_t *>(s.c_str());
+    lens[chunk_size] = s.size();
+    if (++chunk_size == CHUNK_SIZE) {
+      flush_chunk();
+    }
+  }
+  flush_chunk();
+  return result;
+}
+
+} // namespace
+
+array<string> f$md5_batch(const array<string> &strs, bool raw_output) noexcept {
+  return hash_batch<MD5_DIGEST_LENGTH>(strs, raw_output, md5_multi_buffer);
+}
+
+array<string> f$sha1_batch(const array<string> &strs, bool raw_output) noexcept {
+  return hash_batch<SHA_DIGEST_LENGTH>(strs, raw_output, sha1_multi_buffer);
+}
+
+array<int64_t> f$crc32_batch(const array<string> &strs) noexcept {
+  // compute_crc32() is already accelerated with pclmul, so it's just applied to every string
+  array<int64_t> result{strs.size()};
+  for (const auto &it : strs) {
+    const string &s = it.get_value();
+    result.set_value(it.get_key(), compute_crc32(static_cast<const void *>(s.c_str()), s.size()));
+  }
+  return result;
+}
+
+int64_t f$xxh3_64(const string &s) noexcept {
+  return static_cast<int64_t>(xxh3_64(s.c_str(), s.size()));
+}
+
 Optional<string> f$md5_file(const string &file_name, bool raw_output) {
   dl::CriticalSectionSmartGuard critical_section;
   struct stat stat_buf;
@@ -35,6 +35,16 @@ string f$md5(const string &s, bool raw_output = false) noexcept;
 
 Optional<string> f$md5_file(const string &file_name, bool raw_output = false);
 
+// the batch versions hash every string of the array at once with the multi-buffer SIMD code, the keys are preserved
+array<string> f$md5_batch(const array<string> &strs, bool raw_output = false) noexcept;
+
+array<string> f$sha1_batch(const array<string> &strs, bool raw_output = false) noexcept;
+
+array<int64_t> f$crc32_batch(const array<string> &strs) noexcept;
+
+// a fast non-cryptographic hash, e.g. for sharding; the same as hash('xxh3') but as a number
+int64_t f$xxh3_64(const string &s) noexcept;
+
 int64_t f$crc32(const string &s);
 
 int64_t f$crc32_file(const string &file_name);
@@ -5,7 +5,12 @@
 #include "runtime/regexp.h"
 
 #include <cstddef>
+#include <memory>
 #include <re2/re2.h>
+#include <re2/set.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #if ASAN_ENABLED
 #include <sanitizer/lsan_interface.h>
 #endif
@@ -479,7 +484,7 @@ void regexp::init(const char *regexp_string, int64_t regexp_len, const char *fun
 
   can_use_RE2 = can_use_RE2 && is_valid_RE2_regexp(static_SB.c_str(), static_SB.size(), is_utf8, function, file);
 
-  if (is_utf8 && !mb_UTF8_check(static_SB.c_str())) {
+  if (is_utf8 && !mb_UTF8_check(static_SB.c_str(), static_SB.size())) {
     pattern_compilation_warning(function, file, "Regexp \"%s\" contains not UTF-8 symbols", static_SB.c_str());
     clean();
     return;
@@ -674,7 +679,7 @@ Optional<int64_t> regexp::match(const string &subject, bool all_matches) const {
     return false;
   }
 
-  if (is_utf8 && !mb_UTF8_check(subject.c_str())) {
+  if (is_utf8 && !mb_UTF8_check(subject.c_str(), subject.size())) {
     pcre_last_error = PCRE_ERROR_BADUTF8;
     return false;
   }
@@ -748,7 +753,7 @@ Optional<int64_t> regexp::match(const string &subject, mixed &matches, bool all_
     pcre_last_error = PCRE_ERROR_BADUTF8_OFFSET;
     return false;
   }
-  if (is_utf8 && !mb_UTF8_check(subject.c_str())) {
+  if (is_utf8 && !mb_UTF8_check(subject.c_str(), subject.size())) {
     matches = array<mixed>{};
     pcre_last_error = PCRE_ERROR_BADUTF8;
     return false;
@@ -869,7 +874,7 @@ Optional<int64_t> regexp::match(const string &subject, mixed &matches, int64_t f
     pcre_last_error = PCRE_ERROR_BADUTF8_OFFSET;
     return false;
   }
-  if (is_utf8 && !mb_UTF8_check(subject.c_str())) {
+  if (is_utf8 && !mb_UTF8_check(subject.c_str(), subject.size())) {
     matches = array<mixed>{};
     pcre_last_error = PCRE_ERROR_BADUTF8;
     return false;
@@ -966,7 +971,7 @@ Optional<array<mixed>> regexp::split(const string &subject, int64_t limit, int64
     return false;
   }
 
-  if (is_utf8 && !mb_UTF8_check(subject.c_str())) {
+  if (is_utf8 && !mb_UTF8_check(subject.c_str(), subject.size())) {
     pcre_last_error = PCRE_ERROR_BADUTF8;
     return false;
   }
@@ -983,67 +988,41 @@ Optional<array<mixed>> regexp::split(const string &subject, int64_t limit, int64
     limit = INT_MAX;
   }
 
-  int64_t offset = 0;
   int64_t last_match = 0;
-  bool second_try = false;
-
   array<mixed> result;
-  while (offset <= int64_t{subject.size()} && limit > 1) {
-    int64_t count = exec(subject, offset, second_try);
-
-    if (count == 0) {
-      if (second_try) {
-        second_try = false;
-        offset = skip_utf8_subsequent_bytes(offset + 1, subject);
-        continue;
-      }
-
-      break;
+  auto add_piece = [&result, offset_capture](string piece, int64_t piece_offset) {
+    if (offset_capture) {
+      result.push_back(array<mixed>::create(std::move(piece), piece_offset));
+    } else {
+      result.push_back(std::move(piece));
     }
+  };
 
-    if (submatch[0] != last_match || !no_empty) {
-      string match_str(subject.c_str() + last_match, static_cast<string::size_type>(submatch[0] - last_match));
-
-      if (offset_capture) {
-        result.push_back(array<mixed>::create(match_str, last_match));
-      } else {
-        result.push_back(match_str);
+  if (limit > 1) {
+    for_each_match(subject, [&](int64_t count, int64_t match_begin, int64_t match_end) {
+      if (match_begin != last_match || !no_empty) {
+        add_piece(string(subject.c_str() + last_match, static_cast<string::size_type>(match_begin - last_match)), last_match);
+        limit--;
       }
 
-      limit--;
-    }
-
-    if (submatch[1] >= 0) {
-      last_match = submatch[1];
-    }
-
-    if (delim_capture) {
-      for (int64_t i = 1; i < count; i++) {
-        if (submatch[i + i + 1] != submatch[i + i] || !no_empty) {
-          string match_str(subject.c_str() + submatch[i + i], submatch[i + i + 1] - submatch[i + i]);
+      if (match_end >= 0) {
+        last_match = match_end;
+      }
 
-          if (offset_capture) {
-            result.push_back(array<mixed>::create(match_str, submatch[i + i]));
-          } else {
-            result.push_back(match_str);
+      if (delim_capture) {
+        for (int64_t i = 1; i < count; i++) {
+          if (submatch[i + i + 1] != submatch[i + i] || !no_empty) {
+            add_piece(string(subject.c_str() + submatch[i + i], submatch[i + i + 1] - submatch[i + i]), submatch[i + i]);
           }
         }
       }
-    }
-
-    second_try = (submatch[0] == submatch[1]);
 
-    offset = submatch[1];
+      return limit > 1;
+    });
   }
 
   if (last_match < int64_t{subject.size()} || !no_empty) {
-    string match_str(subject.c_str() + last_match, static_cast<string::size_type>(subject.size() - last_match));
-
-    if (offset_capture) {
-      result.push_back(array<mixed>::create(match_str, last_match));
-    } else {
-      result.push_back(match_str);
-    }
+    add_piece(string(subject.c_str() + last_match, static_cast<string::size_type>(subject.size() - last_match)), last_match);
   }
 
   if (pcre_last_error != 0) {
@@ -1074,6 +1053,172 @@ int64_t regexp::last_error() {
 }
 
 
+namespace {
+
+// a set of patterns compiled once and kept in the heap memory for the whole worker lifetime;
+// RE2 requires the same options for all the patterns of a set, so there are separate sets for latin1 and utf8 patterns,
+// and the i, s modifiers are added to the patterns as flags
+class regexp_set : vk::not_copyable {
+public:
+  // the patterns are classified with the usual compilation (in the script memory),
+  // so that they are matched by RE2 exactly when preg_match() would use RE2 for them
+  struct classified_patterns {
+    array<string> re2_patterns[2]; // latin1, utf8; pattern position => the RE2 pattern with flags
+  };
+
+  static classified_patterns classify(const array<string> &patterns) noexcept {
+    classified_patterns classified;
+    int64_t position = 0;
+    for (const auto &it : patterns) {
+      const regexp compiled{it.get_value()};
+      if (const re2::RE2 *re = compiled.get_RE2_regexp()) {
+        const bool is_utf8 = re->options().encoding() == RE2::Options::EncodingUTF8;
+        string flags;
+        if (!re->options().case_sensitive()) {
+          flags.push_back('i');
+        }
+        if (re->options().dot_nl()) {
+          flags.push_back('s');
+        }
+        const string pattern{re->pattern().c_str(), static_cast<string::size_type>(re->pattern().size())};
+        classified.re2_patterns[is_utf8].set_value(position, flags.empty() ? pattern : string("(?").append(flags).append(1, ':').append(pattern).append(1, ')'));
+      }
+      position++;
+    }
+    return classified;
+  }
+
+  // must be called in the critical section
+  regexp_set(const array<string> &patterns, const classified_patterns &classified) noexcept {
+    for (const auto &it : patterns) {
+      const string &pattern = it.get_value();
+      patterns_.emplace_back(pattern.c_str(), pattern.size());
+    }
+    pattern_matched_by_set_.assign(patterns_.size(), false);
+
+    for (int is_utf8 = 0; is_utf8 < 2; is_utf8++) {
+      const array<string> &re2_patterns = classified.re2_patterns[is_utf8];
+      if (re2_patterns.empty()) {
+        continue;
+      }
+      RE2::Options options;
+      options.set_encoding(is_utf8 ? RE2::Options::EncodingUTF8 : RE2::Options::EncodingLatin1);
+      options.set_log_errors(false);
+      auto set = std::make_unique<RE2::Set>(options, RE2::UNANCHORED);
+      std::vector<int64_t> positions;
+      bool ok = true;
+      for (const auto &it : re2_patterns) {
+        const string &pattern = it.get_value();
+        ok = ok && set->Add(re2::StringPiece(pattern.c_str(), pattern.size()), nullptr) == static_cast<int>(positions.size());
+        positions.push_back(it.get_key().to_int());
+      }
+      // otherwise the automaton is too big, and these patterns are checked one by one
+      if (ok && set->Compile()) {
+        for (int64_t position : positions) {
+          pattern_matched_by_set_[position] = true;
+        }
+        sets_[is_utf8] = std::move(set);
+        set_positions_[is_utf8] = std::move(positions);
+      }
+    }
+  }
+
+  array<int64_t> match(const string &subject) const noexcept {
+    array<bool> matched{array_size{static_cast<int64_t>(patterns_.size()), true}};
+    for (size_t i = 0; i < patterns_.size(); i++) {
+      matched.push_back(false);
+    }
+
+    bool set_failed = false;
+    {
+      dl::CriticalSectionGuard critical_section;
+      std::vector<int> matched_indices;
+      for (int is_utf8 = 0; is_utf8 < 2 && !set_failed; is_utf8++) {
+        // like preg_match(), utf8 patterns never match an invalid utf8 subject
+        if (!sets_[is_utf8] || (is_utf8 && !mb_UTF8_check(subject.c_str(), subject.size()))) {
+          continue;
+        }
+        RE2::Set::ErrorInfo error_info{};
+        matched_indices.clear();
+        if (!sets_[is_utf8]->Match(re2::StringPiece(subject.c_str(), subject.size()), &matched_indices, &error_info)) {
+          set_failed = error_info.kind != RE2::Set::kNoError;
+        }
+        for (int index : matched_indices) {
+          matched[set_positions_[is_utf8][index]] = true;
+        }
+      }
+    }
+
+    // if the DFA has run out of memory, all the patterns are checked one by one
+    for (size_t position = 0; position < patterns_.size(); position++) {
+      if (set_failed || !pattern_matched_by_set_[position]) {
+        const Optional<int64_t> result = regexp{string{patterns_[position].c_str(), static_cast<string::size_type>(patterns_[position].size())}}.match(subject, false);
+        matched[static_cast<int64_t>(position)] = result.has_value() && result.val() > 0;
+      }
+    }
+
+    array<int64_t> result;
+    for (const auto &it : matched) {
+      if (it.get_value()) {
+        result.push_back(it.get_key().to_int());
+      }
+    }
+    return result;
+  }
+
+private:
+  std::vector<std::string> patterns_;
+  std::vector<bool> pattern_matched_by_set_;
+  std::unique_ptr<RE2::Set> sets_[2];
+  std::vector<int64_t> set_positions_[2];
+};
+
+// the sets are cached until the limit is reached, after that new sets are compiled for every call
+constexpr size_t MAX_CACHED_REGEXP_SETS = 1024;
+
+} // namespace
+
+array<int64_t> f$preg_match_set(const array<string> &patterns, const string &subject) {
+  static std::unordered_map<std::string, std::unique_ptr<regexp_set>> regexp_sets_cache;
+
+  std::string key;
+  const regexp_set *set = nullptr;
+  {
+    dl::CriticalSectionGuard critical_section;
+    for (const auto &it : patterns) {
+      const string &pattern = it.get_value();
+      const auto len = static_cast<uint32_t>(pattern.size());
+      key.append(reinterpret_cast<const char *>(&len), sizeof(len)).append(pattern.c_str(), pattern.size());
+    }
+    auto cached = regexp_sets_cache.find(key);
+    if (cached != regexp_sets_cache.end()) {
+      set = cached->second.get();
+    }
+  }
+  if (set) {
+    return set->match(subject);
+  }
+
+  const auto classified = regexp_set::classify(patterns);
+  std::unique_ptr<regexp_set> new_set;
+  {
+    dl::CriticalSectionGuard critical_section;
+    new_set = std::make_unique<regexp_set>(patterns, classified);
+    if (regexp_sets_cache.size() < MAX_CACHED_REGEXP_SETS) {
+      set = regexp_sets_cache.emplace(std::move(key), std::move(new_set)).first->second.get();
+    } else {
+      set = new_set.get();
+      key = std::string{};
+    }
+  }
+  array<int64_t> result = set->match(subject);
+  if (new_set) {
+    dl::CriticalSectionGuard critical_section;
+    new_set.reset();
+  }
+  return result;
+}
+
 string f$preg_quote(const string &str, const string &delimiter) {
   const string::size_type len = str.size();
 
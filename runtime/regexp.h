@@ -66,8 +66,14 @@ private:
 
   static int32_t submatch[3 * MAX_SUBPATTERNS];
 
+  template<class F>
+  inline void for_each_match(const string &subject, F &&on_match) const;
+
+  inline void append_replacement(const string &replace_val, const string &subject, int64_t count, string &result) const;
+
   template<class T>
-  inline string get_replacement(const T &replace_val, const string &subject, int64_t count) const;
+  inline void append_callback_replacement(const T &replace_val, const string &subject, int64_t count, string &result,
+                                          array<string> &matches, int64_t &matches_count) const;
 
   void pattern_compilation_warning(const char *function, const char *file, char const *message, ...) noexcept __attribute__ ((format (printf, 4, 5)));
 
@@ -84,6 +90,11 @@ public:
   void init(const string &regexp_string, const char *function = nullptr, const char *file = nullptr);
   void init(const char *regexp_string, int64_t regexp_len, const char *function = nullptr, const char *file = nullptr);
 
+  // the RE2 automaton if it's used instead of PCRE; null for the patterns that RE2 doesn't support
+  const re2::RE2 *get_RE2_regexp() const noexcept {
+    return RE2_regexp;
+  }
+
   bool does_need_compilation() const {
     // const regexps are compiled beforehand in master process and stored in heap memory
     // if not, regexp needs to be compiled every time in preg_match() and similar
@@ -195,6 +206,10 @@ inline Optional<array<mixed>> f$preg_split(const string &regex, const string &su
 
 inline Optional<array<mixed>> f$preg_split(const mixed &regex, const string &subject, int64_t limit = -1, int64_t flags = 0);
 
+// returns the positions (in the iteration order) of the patterns that match the subject, like preg_match() does;
+// all the patterns supported by RE2 are matched at once with the cached RE2::Set, the others are checked one by one with PCRE
+array<int64_t> f$preg_match_set(const array<string> &patterns, const string &subject);
+
 string f$preg_quote(const string &str, const string &delimiter = string());
 
 inline int64_t f$preg_last_error();
@@ -207,67 +222,119 @@ inline int64_t f$preg_last_error();
  */
 
 
-template<>
-inline string regexp::get_replacement(const string &replace_val, const string &subject, int64_t count) const {
+// the matching core of replace() and split(): on_match(count, match_begin, match_end) is called for every match
+// while it returns true, the submatch offsets are valid till it calls anything that can run other regexps
+template<class F>
+void regexp::for_each_match(const string &subject, F &&on_match) const {
+  int64_t offset = 0;
+  bool second_try = false;//set after matching an empty string
+  while (offset <= int64_t{subject.size()}) {
+    const int64_t count = exec(subject, offset, second_try);
+    if (count == 0) {
+      if (second_try) {
+        second_try = false;
+        offset = skip_utf8_subsequent_bytes(offset + 1, subject);
+        continue;
+      }
+
+      break;
+    }
+
+    const int64_t match_begin = submatch[0];
+    const int64_t match_end = submatch[1];
+    if (!on_match(count, match_begin, match_end)) {
+      break;
+    }
+
+    second_try = (match_begin == match_end);
+    offset = match_end;
+  }
+}
+
+// the replacement with backreferences (\n, $n, ${n}) is written right to the result, the literal parts are copied by runs
+void regexp::append_replacement(const string &replace_val, const string &subject, int64_t count, string &result) const {
   const string::size_type len = replace_val.size();
 
-  static_SB.clean();
+  string::size_type literal_begin = 0;
   for (string::size_type i = 0; i < len; i++) {
+    if (replace_val[i] != '\\' && replace_val[i] != '$') {
+      continue;
+    }
+
     int64_t backref = -1;
+    string::size_type skip_to = i;
     if (replace_val[i] == '\\' && (replace_val[i + 1] == '\\' || replace_val[i + 1] == '$')) {
-      i++;
-    } else if ((replace_val[i] == '\\' || replace_val[i] == '$') && '0' <= replace_val[i + 1] && replace_val[i + 1] <= '9') {
+      // the escaped char is kept as the beginning of the next literal run
+      result.append(replace_val.c_str() + literal_begin, i - literal_begin);
+      literal_begin = ++i;
+      continue;
+    } else if ('0' <= replace_val[i + 1] && replace_val[i + 1] <= '9') {
       if ('0' <= replace_val[i + 2] && replace_val[i + 2] <= '9') {
         backref = (replace_val[i + 1] - '0') * 10 + (replace_val[i + 2] - '0');
-        i += 2;
+        skip_to = i + 2;
       } else {
         backref = replace_val[i + 1] - '0';
-        i++;
+        skip_to = i + 1;
       }
     } else if (replace_val[i] == '$' && replace_val[i + 1] == '{' && '0' <= replace_val[i + 2] && replace_val[i + 2] <= '9') {
       if ('0' <= replace_val[i + 3] && replace_val[i + 3] <= '9') {
         if (replace_val[i + 4] == '}') {
           backref = (replace_val[i + 2] - '0') * 10 + (replace_val[i + 3] - '0');
-          i += 4;
+          skip_to = i + 4;
         }
       } else {
         if (replace_val[i + 3] == '}') {
           backref = replace_val[i + 2] - '0';
-          i += 3;
+          skip_to = i + 3;
         }
       }
     }
 
-    if (backref == -1) {
-      static_SB << replace_val[i];
-    } else {
+    if (backref != -1) {
+      result.append(replace_val.c_str() + literal_begin, i - literal_begin);
       if (backref < count) {
-        int64_t index = backref + backref;
-        static_SB.append(subject.c_str() + submatch[index],
-                         static_cast<size_t>(submatch[index + 1] - submatch[index]));
+        const int64_t index = backref + backref;
+        result.append(subject.c_str() + submatch[index], static_cast<string::size_type>(submatch[index + 1] - submatch[index]));
       }
+      i = skip_to;
+      literal_begin = i + 1;
     }
   }
-  return static_SB.str();//TODO optimize
+  result.append(replace_val.c_str() + literal_begin, len - literal_begin);
 }
 
+// one matches array is used for all the callback calls: if the callback hasn't kept it and the number of groups is the same,
+// its strings are overwritten in place, otherwise the copy-on-write makes a new one
 template<class T>
-string regexp::get_replacement(const T &replace_val, const string &subject, const int64_t count) const {
-  array<string> result_set(array_size(count + named_subpatterns_count, named_subpatterns_count == 0));
+void regexp::append_callback_replacement(const T &replace_val, const string &subject, int64_t count, string &result,
+                                         array<string> &matches, int64_t &matches_count) const {
+  if (count != matches_count) {
+    matches = array<string>(array_size(count + named_subpatterns_count, named_subpatterns_count == 0));
+    matches_count = count;
 
-  if (named_subpatterns_count) {
     for (int64_t i = 0; i < count; i++) {
       const string match_str(subject.c_str() + submatch[i + i], submatch[i + i + 1] - submatch[i + i]);
-
-      preg_add_match(result_set, match_str, subpattern_names[i]);
+      if (named_subpatterns_count) {
+        preg_add_match(matches, match_str, subpattern_names[i]);
+      } else {
+        matches.push_back(match_str);
+      }
     }
   } else {
     for (int64_t i = 0; i < count; i++) {
-      result_set.push_back(string(subject.c_str() + submatch[i + i], submatch[i + i + 1] - submatch[i + i]));
+      const char *match_begin = subject.c_str() + submatch[i + i];
+      const auto match_len = static_cast<string::size_type>(submatch[i + i + 1] - submatch[i + i]);
+      if (named_subpatterns_count && subpattern_names[i].size()) {
+        const string match_str(match_begin, match_len);
+        matches.set_value(subpattern_names[i], match_str);
+        matches.set_value(i, match_str);
+      } else {
+        matches[i].assign(match_begin, match_len);
+      }
     }
   }
 
-  return f$strval(replace_val(result_set));
+  result.append(f$strval(replace_val(matches)));
 }
 
 
@@ -281,7 +348,7 @@ Optional<string> regexp::replace(const T &replace_val, const string &subject, in
     return {};
   }
 
-  if (is_utf8 && !mb_UTF8_check(subject.c_str())) {
+  if (is_utf8 && !mb_UTF8_check(subject.c_str(), subject.size())) {
     pcre_last_error = PCRE_ERROR_BADUTF8;
     return {};
   }
@@ -290,39 +357,25 @@ Optional<string> regexp::replace(const T &replace_val, const string &subject, in
     limit = INT_MAX;
   }
 
-  int64_t offset = 0;
   int64_t last_match = 0;
-  bool second_try = false;
-
   string result;
-  while (offset <= int64_t{subject.size()} && limit > 0) {
-    int64_t count = exec(subject, offset, second_try);
-
-//    fprintf (stderr, "Found %d submatches at %d:%d from pos %d, pcre_last_error = %d\n", count, submatch[0], submatch[1], offset, pcre_last_error);
-    if (count == 0) {
-      if (second_try) {
-        second_try = false;
-        do {
-          offset++;
-        } while (is_utf8 && offset < int64_t{subject.size()} && (static_cast<unsigned char>(subject[static_cast<string::size_type>(offset)]) & 0xc0) == 0x80);
-        continue;
+  array<string> matches;
+  int64_t matches_count = -1;
+  if (limit > 0) {
+    for_each_match(subject, [&](int64_t count, int64_t match_begin, int64_t match_end) {
+      result_count++;
+      limit--;
+
+      result.append(subject.c_str() + last_match, static_cast<string::size_type>(match_begin - last_match));
+      if constexpr (std::is_same<T, string>{}) {
+        append_replacement(replace_val, subject, count, result);
+      } else {
+        append_callback_replacement(replace_val, subject, count, result, matches, matches_count);
       }
 
-      break;
-    }
-
-    result_count++;
-    limit--;
-
-    int64_t match_begin = submatch[0];
-    offset = submatch[1];
-
-    result.append(subject.c_str() + last_match, static_cast<string::size_type>(match_begin - last_match));
-    result.append(get_replacement(replace_val, subject, count));
-
-    second_try = (match_begin == offset);
-
-    last_match = offset;
+      last_match = match_end;
+      return limit > 0;
+    });
   }
 
   replace_count = result_count;
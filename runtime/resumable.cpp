@@ -73,6 +73,7 @@ struct forked_resumable_info : resumable_info {
   // x < 0 - (-id) of next finished function in the same queue or -2 if none
   int64_t queue_id;
   double running_time;
+  double file_io_wait_time;
 };
 
 struct started_resumable_info : resumable_info {
@@ -204,6 +205,7 @@ int64_t register_forked_resumable(Resumable *resumable) {
   res->queue_id = 0;
   res->son = 0;
   res->running_time = 0;
+  res->file_io_wait_time = 0;
   res->name = resumable ? typeid(*resumable).name() : "(null)";
 
   return res_id;
@@ -266,9 +268,16 @@ Optional<array<mixed>> f$get_fork_stat(int64_t fork_id) {
     running_time += get_precise_now();
   }
   result.set_value(string("work_time"), running_time);
+  result.set_value(string("file_io_wait_time"), info->file_io_wait_time);
   return result;
 }
 
+void add_running_fork_file_io_wait_time(double wait_time) noexcept {
+  if (int64_t fork_id = f$get_running_fork_id()) {
+    get_forked_resumable_info(fork_id)->file_io_wait_time += wait_time;
+  }
+}
+
 static int64_t register_started_resumable(Resumable *resumable) noexcept {
   int64_t res_id;
   bool is_new = false;
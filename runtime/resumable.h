@@ -114,6 +114,7 @@ Optional<int64_t> f$wait_queue_next_synchronously(int64_t queue_id);
 
 int64_t f$get_running_fork_id();
 Optional<array<mixed>> f$get_fork_stat(int64_t fork_id);
+void add_running_fork_file_io_wait_time(double wait_time) noexcept;
 
 template<typename T, bool use_autogenerated_loader = true>
 class wait_result_resumable final : public Resumable {
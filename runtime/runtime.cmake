@@ -82,6 +82,7 @@ prepend(KPHP_RUNTIME_SOURCES ${BASE_DIR}/runtime/
         exception.cpp
         exec.cpp
         files.cpp
+        files-async.cpp
         from-json-processor.cpp
         instance-cache.cpp
         instance-copy-processor.cpp
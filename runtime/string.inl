@@ -6,6 +6,7 @@
 
 #include <cctype>
 
+#include "common/algorithms/number-conversions.h"
 #include "common/algorithms/simd-int-to-string.h"
 
 #include "runtime/string_cache.h"
@@ -232,6 +233,12 @@ string::string(int64_t i) {
 }
 
 string::string(double f) {
+  char fast_result[STRLEN_FLOAT];
+  if (const size_t fast_len = try_format_float_precision14(f, fast_result)) {
+    p = create(fast_result, fast_result + fast_len);
+    return;
+  }
+
   constexpr uint32_t MAX_LEN = 4096;
   char result[MAX_LEN + 2];
   result[0] = '\0';
@@ -723,6 +730,9 @@ bool string::try_to_float_as_php8(double *val) const {
   if (empty() || (size() >= 2 && p[0] == '0' && vk::any_of_equal(p[1], 'x', 'X'))) {
     return false;
   }
+  if (try_parse_simple_decimal(p, size(), val)) {
+    return true;
+  }
   char *end_ptr = nullptr;
   *val = strtod(p, &end_ptr);
 
@@ -736,6 +746,9 @@ bool string::try_to_float_as_php7(double *val) const {
   if (empty() || (size() >= 2 && p[0] == '0' && vk::any_of_equal(p[1], 'x', 'X'))) {
     return false;
   }
+  if (try_parse_simple_decimal(p, size(), val)) {
+    return true;
+  }
   char *end_ptr{nullptr};
   *val = strtod(p, &end_ptr);
   return (end_ptr == p + size());
@@ -1100,13 +1113,7 @@ bool is_ok_float(double v) {
 }
 
 inline bool is_all_digits(const string &s) {
-  for (string::size_type i = 0; i < s.size(); ++i) {
-    if (!('0' <= s[i] && s[i] <= '9')) {
-      return false;
-    }
-  }
-
-  return true;
+  return are_all_digits(s.c_str(), s.size());
 }
 
 int64_t compare_strings_php_order(const string &lhs, const string &rhs) {
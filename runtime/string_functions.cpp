@@ -8,6 +8,7 @@
 #include <sys/types.h>
 #include <cctype>
 
+#include "common/algorithms/simd-int-to-string.h"
 #include "common/macos-ports.h"
 #include "common/unicode/unicode-utils.h"
 
@@ -1002,6 +1003,68 @@ Optional<string> f$setlocale(int64_t category, const string &locale) {
   return string(res);
 }
 
+// writes the integer sprintf() conversion (b, d, o, u, x, X) of value to out, returns the end of the written piece
+static char *sprintf_int_piece(int64_t value, char conversion, bool plus_sign, char *out) noexcept {
+  switch (conversion) {
+    case 'd':
+      if (plus_sign && value >= 0) {
+        *out++ = '+';
+      }
+      return simd_int64_to_string(value, out);
+    case 'u':
+      return simd_uint64_to_string(static_cast<uint64_t>(value), out);
+    default: {
+      const int shift = conversion == 'b' ? 1 : (conversion == 'o' ? 3 : 4);
+      const char *digits = conversion == 'X' ? uhex_digits : lhex_digits;
+      auto u = static_cast<uint64_t>(value);
+      char buf[64];
+      char *begin = buf + sizeof(buf);
+      do {
+        *--begin = digits[u & ((1 << shift) - 1)];
+        u >>= shift;
+      } while (u > 0);
+      return std::copy(begin, buf + sizeof(buf), out);
+    }
+  }
+}
+
+// the same as str_pad(piece, width, filler, pad_right), but without a temporary string for the piece
+static string sprintf_pad(const char *piece, string::size_type len, int64_t width, int64_t filler, bool pad_right) {
+  if (width <= static_cast<int64_t>(len)) {
+    return {piece, len};
+  }
+  string result(static_cast<string::size_type>(width), static_cast<char>(filler));
+  memcpy(&result[pad_right ? 0 : static_cast<string::size_type>(width) - len], piece, len);
+  return result;
+}
+
+string f$_sprintf_int(int64_t value, int64_t conversion, int64_t width, int64_t filler, bool pad_right, bool plus_sign) {
+  char buf[72];
+  const char *end = sprintf_int_piece(value, static_cast<char>(conversion), plus_sign, buf);
+  return sprintf_pad(buf, end - buf, width, filler, pad_right);
+}
+
+string f$_sprintf_float(double value, const string &c_format, int64_t width, int64_t filler, bool pad_right) {
+  const int len = snprintf(php_buf, PHP_BUF_LEN, c_format.c_str(), value);
+  if (len >= PHP_BUF_LEN) {
+    php_warning("Too big result in function sprintf");
+    return {};
+  }
+  return sprintf_pad(php_buf, len, width, filler, pad_right);
+}
+
+string f$_sprintf_string(const string &value, int64_t precision, int64_t width, int64_t filler, bool pad_right) {
+  // like snprintf() in f$sprintf(), the string is cut at '\0'; the compiler passes a precision that is less than PHP_BUF_LEN
+  string::size_type len = precision >= 0 ? std::min<string::size_type>(value.size(), precision) : value.size();
+  if (const void *zero = memchr(value.c_str(), '\0', len)) {
+    len = static_cast<const char *>(zero) - value.c_str();
+  }
+  if (len == value.size() && width <= static_cast<int64_t>(len)) {
+    return value;
+  }
+  return sprintf_pad(value.c_str(), len, width, filler, pad_right);
+}
+
 string f$sprintf(const string &format, const array<mixed> &a) {
   string result;
   result.reserve_at_least(format.size());
@@ -1093,16 +1156,14 @@ string f$sprintf(const string &format, const array<mixed> &a) {
       }
 
       switch (format[i]) {
-        case 'b': {
-          auto arg_int = static_cast<uint64_t>(arg.to_int());
-          int cur_pos = 70;
-          do {
-            php_buf[--cur_pos] = (char)((arg_int & 1) + '0');
-            arg_int >>= 1;
-          } while (arg_int > 0);
-          piece.assign(php_buf + cur_pos, 70 - cur_pos);
+        case 'b':
+        case 'd':
+        case 'o':
+        case 'u':
+        case 'x':
+        case 'X':
+          piece.assign(php_buf, static_cast<string::size_type>(sprintf_int_piece(arg.to_int(), format[i], sign == '+', php_buf) - php_buf));
           break;
-        }
         case 'c': {
           int64_t arg_int = arg.to_int();
           if (arg_int <= -128 || arg_int > 255) {
@@ -1111,25 +1172,6 @@ string f$sprintf(const string &format, const array<mixed> &a) {
           piece.assign(1, (char)arg_int);
           break;
         }
-        case 'd': {
-          int64_t arg_int = arg.to_int();
-          if (sign == '+' && arg_int >= 0) {
-            piece = (static_SB.clean() << "+" << arg_int).str();
-          } else {
-            piece = string(arg_int);
-          }
-          break;
-        }
-        case 'u': {
-          auto arg_int = static_cast<uint64_t>(arg.to_int());
-          int cur_pos = 70;
-          do {
-            php_buf[--cur_pos] = (char)(arg_int % 10 + '0');
-            arg_int /= 10;
-          } while (arg_int > 0);
-          piece.assign(php_buf + cur_pos, 70 - cur_pos);
-          break;
-        }
         case 'e':
         case 'E':
         case 'f':
@@ -1156,16 +1198,6 @@ string f$sprintf(const string &format, const array<mixed> &a) {
           piece.assign(php_buf, len);
           break;
         }
-        case 'o': {
-          auto arg_int = static_cast<uint64_t>(arg.to_int());
-          int cur_pos = 70;
-          do {
-            php_buf[--cur_pos] = (char)((arg_int & 7) + '0');
-            arg_int >>= 3;
-          } while (arg_int > 0);
-          piece.assign(php_buf + cur_pos, 70 - cur_pos);
-          break;
-        }
         case 's': {
           string arg_string = arg.to_string();
 
@@ -1184,19 +1216,6 @@ string f$sprintf(const string &format, const array<mixed> &a) {
           piece.assign(php_buf, len);
           break;
         }
-        case 'x':
-        case 'X': {
-          const char *hex_digits = (format[i] == 'x' ? lhex_digits : uhex_digits);
-          auto arg_int = static_cast<uint64_t>(arg.to_int());
-
-          int cur_pos = 70;
-          do {
-            php_buf[--cur_pos] = hex_digits[arg_int & 15];
-            arg_int >>= 4;
-          } while (arg_int > 0);
-          piece.assign(php_buf + cur_pos, 70 - cur_pos);
-          break;
-        }
         default:
           php_warning("Unsupported specifier %%%c in sprintf with format \"%s\"", format[i], format.c_str());
           return {};
@@ -92,6 +92,11 @@ Optional<string> f$setlocale(int64_t category, const string &locale);
 
 string f$sprintf(const string &format, const array<mixed> &a);
 
+// sprintf() with a constant format is compiled into a concatenation, where these functions format the specifiers with modifiers
+string f$_sprintf_int(int64_t value, int64_t conversion, int64_t width, int64_t filler, bool pad_right, bool plus_sign);
+string f$_sprintf_float(double value, const string &c_format, int64_t width, int64_t filler, bool pad_right);
+string f$_sprintf_string(const string &value, int64_t precision, int64_t width, int64_t filler, bool pad_right);
+
 string f$stripcslashes(const string &str);
 
 string f$stripslashes(const string &str);
@@ -4,6 +4,7 @@
 
 #include "runtime/url.h"
 
+#include "common/algorithms/simd-url.h"
 #include "common/macos-ports.h"
 
 #include "runtime/array_functions.h"
@@ -51,17 +52,20 @@ Optional<string> f$base64_decode(const string &s, bool strict) {
   /* run through the whole string, converting as we go */
   string::size_type result_len = (s.size() + 3) / 4 * 3;
   string result(result_len, false);
-  int i = 0;
-  string::size_type j = 0;
+  /* the leading blocks of pure base64 alphabet chars are decoded with SIMD,
+   * padding, whitespace and bad characters are left for the loop below */
+  const string::size_type decoded = simd_base64_decode_blocks(s.c_str(), s.size(), reinterpret_cast<unsigned char *>(result.buffer()), result_len);
+  int i = static_cast<int>(decoded);
+  string::size_type j = decoded / 4 * 3;
   int padding = 0;
-  for (string::size_type pos = 0; pos < s.size(); pos++) {
+  for (string::size_type pos = decoded; pos < s.size(); pos++) {
     int ch = s[pos];
     if (ch == '=') {
       padding++;
       continue;
     }
 
-    ch = base64_reverse_table[ch];
+    ch = base64_reverse_table[static_cast<unsigned char>(ch)];
     if (!strict) {
       /* skip unknown characters and whitespace */
       if (ch < 0) {
@@ -158,7 +162,10 @@ int base64_encode(const unsigned char *const input, int ilen, char *output, int
 string f$base64_encode(const string &s) {
   int result_len = (s.size() + 2) / 3 * 4;
   string res(result_len, false);
-  result_len = base64_encode(reinterpret_cast <const unsigned char *> (s.c_str()), (int)s.size(), res.buffer(), result_len + 1);
+  const auto *input = reinterpret_cast <const unsigned char *> (s.c_str());
+  const int encoded = static_cast<int>(simd_base64_encode_blocks(input, s.size(), res.buffer()));
+  const int written = encoded / 3 * 4;
+  result_len = base64_encode(input + encoded, (int)s.size() - encoded, res.buffer() + written, result_len + 1 - written);
 
   if (result_len != 0) {
     return {};
@@ -472,22 +479,13 @@ string f$rawurldecode(const string &s) {
   return static_SB.str();
 }
 
-
-static const char *good_url_symbols =
-  "00000000000000000000000000000000"
-  "00000000000001101111111111000000"
-  "01111111111111111111111111100001"
-  "01111111111111111111111111100000"
-  "00000000000000000000000000000000"
-  "00000000000000000000000000000000"
-  "00000000000000000000000000000000"
-  "00000000000000000000000000000000";//[0-9a-zA-Z-_.]
-
 string f$rawurlencode(const string &s) {
   static_SB.clean().reserve(3 * s.size());
   for (int i = 0; i < (int)s.size(); i++) {
-    if (good_url_symbols[(unsigned char)s[i]] == '1') {
-      static_SB.append_char(s[i]);
+    const int unreserved_len = static_cast<int>(url_unreserved_prefix_length(s.c_str() + i, s.size() - i));
+    if (unreserved_len) {
+      static_SB.append(s.c_str() + i, unreserved_len);
+      i += unreserved_len - 1;
     } else {
       static_SB.append_char('%');
       static_SB.append_char(uhex_digits[(s[i] >> 4) & 15]);
@@ -522,8 +520,10 @@ string f$urldecode(const string &s) {
 string f$urlencode(const string &s) {
   static_SB.clean().reserve(3 * s.size());
   for (int i = 0; i < (int)s.size(); i++) {
-    if (good_url_symbols[(unsigned char)s[i]] == '1') {
-      static_SB.append_char(s[i]);
+    const int unreserved_len = static_cast<int>(url_unreserved_prefix_length(s.c_str() + i, s.size() - i));
+    if (unreserved_len) {
+      static_SB.append(s.c_str() + i, unreserved_len);
+      i += unreserved_len - 1;
     } else if (s[i] == ' ') {
       static_SB.append_char('+');
     } else {
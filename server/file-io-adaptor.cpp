@@ -0,0 +1,248 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#include "server/file-io-adaptor.h"
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <thread>
+#include <unistd.h>
+
+#include "common/dl-utils-lite.h"
+#include "net/net-events.h"
+#include "runtime/critical_section.h"
+#include "runtime/net_events.h"
+#include "runtime/resumable.h"
+#include "server/php-engine-vars.h"
+#include "server/php-engine.h"
+#include "server/php-queries.h"
+#include "server/server-log.h"
+#include "server/slot-ids-factory.h"
+
+template<>
+int Storage::tagger<std::unique_ptr<file_io_async::FileIoOperation>>::get_tag() noexcept {
+  return -1893127611;
+}
+
+namespace file_io_async {
+
+namespace {
+
+// file reads and writes mostly wait for the disk, so a couple of threads are enough for a worker
+constexpr int FILE_IO_THREADS_COUNT = 2;
+
+bool set_nonblocking(int fd) noexcept {
+  const int flags = fcntl(fd, F_GETFL, 0);
+  return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) >= 0;
+}
+
+void execute_operation(FileIoOperation *operation) noexcept {
+  while (operation->processed < operation->size) {
+    char *buf = operation->buffer + operation->processed;
+    const size_t len = operation->size - operation->processed;
+    const ssize_t res = operation->type == FileIoOperation::Type::read ? read(operation->fd, buf, len) : write(operation->fd, buf, len);
+    if (res < 0) {
+      if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK) {
+        continue;
+      }
+      operation->error = errno;
+      return;
+    }
+    if (res == 0) {
+      return;
+    }
+    operation->processed += res;
+  }
+}
+
+} // namespace
+
+FileIoOperation::FileIoOperation(Type type, int request_id, int fd, size_t size) noexcept
+  : type(type)
+  , request_id(request_id)
+  , fd(fd)
+  , buffer(new char[size > 0 ? size : 1])
+  , size(size) {}
+
+FileIoOperation::~FileIoOperation() noexcept {
+  dl::CriticalSectionGuard critical_section;
+  delete[] buffer;
+  if (fd >= 0) {
+    close(fd);
+  }
+}
+
+class FileIoAdaptor::FileIoOperationResumable final : public Resumable {
+  using ReturnT = std::unique_ptr<FileIoOperation>;
+  int request_id{0};
+
+public:
+  explicit FileIoOperationResumable(int request_id) noexcept
+    : request_id(request_id) {}
+
+  bool is_internal_resumable() const noexcept final {
+    return true;
+  }
+protected:
+  bool run() final {
+    ReturnT res = vk::singleton<FileIoAdaptor>::get().withdraw_operation(request_id);
+    RETURN(std::move(res));
+  }
+};
+
+bool FileIoAdaptor::is_available() noexcept {
+  if (!inited) {
+    inited = true;
+    available = init();
+  }
+  return available;
+}
+
+bool FileIoAdaptor::init() noexcept {
+  dl::CriticalSectionGuard critical_section;
+  int fds[2];
+  if (pipe(fds) < 0) {
+    log_server_error("Can't create a pipe for the file I/O threads: %s", strerror(errno));
+    return false;
+  }
+  if (!set_nonblocking(fds[0]) || !set_nonblocking(fds[1])) {
+    log_server_error("Can't make the file I/O threads pipe non-blocking: %s", strerror(errno));
+    close(fds[0]);
+    close(fds[1]);
+    return false;
+  }
+  notify_read_fd = fds[0];
+  notify_write_fd = fds[1];
+  epoll_sethandler(notify_read_fd, 0, FileIoAdaptor::on_operations_finished, nullptr);
+  epoll_insert(notify_read_fd, EVT_READ);
+
+  // the runtime signals must be handled by the main thread only, the threads inherit the signal mask
+  sigset_t sigset = dl_get_empty_sigset();
+  sigaddset(&sigset, SIGALRM);
+  sigaddset(&sigset, SIGUSR1);
+  sigaddset(&sigset, SIGUSR2);
+  sigaddset(&sigset, SIGPHPASSERT);
+  sigaddset(&sigset, SIGSTACKOVERFLOW);
+  pthread_sigmask(SIG_BLOCK, &sigset, nullptr);
+  for (int i = 0; i < FILE_IO_THREADS_COUNT; ++i) {
+    // the threads live as long as the worker process does
+    std::thread{[this] { run_io_thread(); }}.detach();
+  }
+  pthread_sigmask(SIG_UNBLOCK, &sigset, nullptr);
+  return true;
+}
+
+void FileIoAdaptor::run_io_thread() noexcept {
+  while (true) {
+    FileIoOperation *operation = nullptr;
+    {
+      std::unique_lock<std::mutex> lock{pending_mutex};
+      pending_cv.wait(lock, [this] { return pending_head != nullptr; });
+      operation = pending_head;
+      pending_head = operation->next;
+      if (pending_head == nullptr) {
+        pending_tail = nullptr;
+      }
+    }
+
+    execute_operation(operation);
+
+    {
+      std::lock_guard<std::mutex> lock{finished_mutex};
+      operation->next = finished_head;
+      finished_head = operation;
+    }
+    // the pipe may be full only if the main thread hasn't read the previous notifications yet, so it's fine to skip this one
+    const char notification = 0;
+    while (write(notify_write_fd, &notification, 1) < 0 && errno == EINTR) {
+    }
+  }
+}
+
+int FileIoAdaptor::on_operations_finished(int fd, void *data __attribute__((unused)), event_descr *ev __attribute__((unused))) noexcept {
+  char buf[64];
+  while (read(fd, buf, sizeof(buf)) > 0) {
+  }
+  vk::singleton<FileIoAdaptor>::get().finish_operations();
+  return 0;
+}
+
+void FileIoAdaptor::finish_operations() noexcept {
+  FileIoOperation *operation = nullptr;
+  {
+    std::lock_guard<std::mutex> lock{finished_mutex};
+    operation = finished_head;
+    finished_head = nullptr;
+  }
+
+  while (operation != nullptr) {
+    std::unique_ptr<FileIoOperation> finished{operation};
+    operation = operation->next;
+    finished->next = nullptr;
+
+    int event_status = 0;
+    if (file_io_requests_factory.is_from_current_script_execution(finished->request_id)) {
+      net_event_t *event = nullptr;
+      event_status = alloc_net_event(finished->request_id, &event);
+      if (event_status > 0) {
+        event->data = finished.release();
+        event_status = 1;
+      }
+    }
+    on_net_event(event_status);
+  }
+}
+
+int FileIoAdaptor::launch_operation_resumable(std::unique_ptr<FileIoOperation> &&operation) noexcept {
+  const int request_id = operation->request_id;
+  net_query_t *query = create_net_query();
+  query->slot_id = request_id;
+  query->data = operation.release();
+  int resumable_id = register_forked_resumable(new FileIoOperationResumable{request_id});
+  processing_operations.insert(request_id, OperationInfo{resumable_id});
+
+  update_precise_now();
+  wait_net(0);
+  update_precise_now();
+
+  return resumable_id;
+}
+
+void FileIoAdaptor::process_operation_net_query(FileIoOperation *operation) noexcept {
+  {
+    std::lock_guard<std::mutex> lock{pending_mutex};
+    if (pending_tail != nullptr) {
+      pending_tail->next = operation;
+    } else {
+      pending_head = operation;
+    }
+    pending_tail = operation;
+  }
+  pending_cv.notify_one();
+}
+
+void FileIoAdaptor::process_response_event(std::unique_ptr<FileIoOperation> &&operation) noexcept {
+  const int request_id = operation->request_id;
+  auto *info = processing_operations.get(request_id);
+  if (info == nullptr) {
+    return;
+  }
+  const int resumable_id = info->resumable_id;
+  processing_operations.insert_or_assign(request_id, OperationInfo{resumable_id, std::move(operation)});
+  resumable_run_ready(resumable_id);
+}
+
+std::unique_ptr<FileIoOperation> FileIoAdaptor::withdraw_operation(int request_id) noexcept {
+  OperationInfo info = processing_operations.extract(request_id);
+  php_assert(info.resumable_id != 0);
+  php_assert(info.operation);
+  return std::move(info.operation);
+}
+
+void FileIoAdaptor::reset() noexcept {
+  processing_operations.clear();
+}
+} // namespace file_io_async
@@ -0,0 +1,88 @@
+// Compiler for PHP (aka KPHP)
+// Copyright (c) 2023 LLC «V Kontakte»
+// Distributed under the GPL v3 License, see LICENSE.notice.txt
+
+#pragma once
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+
+#include "common/mixin/not_copyable.h"
+#include "common/smart_ptrs/singleton.h"
+#include "runtime/signal_safe_hashtable.h"
+
+struct event_descr;
+
+namespace file_io_async {
+
+/**
+ * A file operation which is prepared by the script, executed by an I/O thread and then returned back to the script.
+ * I/O threads don't allocate any memory (the global malloc may be switched to the script allocator at any moment),
+ * so all the buffers are allocated by the main thread before the operation is submitted.
+ */
+struct FileIoOperation : vk::not_copyable {
+  enum class Type {
+    read,
+    write
+  };
+
+  FileIoOperation(Type type, int request_id, int fd, size_t size) noexcept;
+  ~FileIoOperation() noexcept;
+
+  const Type type;
+  const int request_id{0};
+  const int fd{-1};
+  // the read data or the data to be written
+  char *const buffer{nullptr};
+  const size_t size{0};
+
+  // the results, they are set by an I/O thread
+  size_t processed{0};
+  int error{0};
+
+  FileIoOperation *next{nullptr};
+};
+
+class FileIoAdaptor : vk::not_copyable {
+public:
+  bool is_available() noexcept;
+
+  int launch_operation_resumable(std::unique_ptr<FileIoOperation> &&operation) noexcept;
+  void process_operation_net_query(FileIoOperation *operation) noexcept;
+  void process_response_event(std::unique_ptr<FileIoOperation> &&operation) noexcept;
+
+  std::unique_ptr<FileIoOperation> withdraw_operation(int request_id) noexcept;
+  void reset() noexcept;
+
+private:
+  FileIoAdaptor() = default;
+  friend class vk::singleton<FileIoAdaptor>;
+
+  struct OperationInfo {
+    int resumable_id{0};
+    std::unique_ptr<FileIoOperation> operation;
+  };
+  class FileIoOperationResumable;
+
+  bool init() noexcept;
+  void run_io_thread() noexcept;
+  void finish_operations() noexcept;
+  static int on_operations_finished(int fd, void *data, event_descr *ev) noexcept;
+
+  bool inited{false};
+  bool available{false};
+  int notify_read_fd{-1};
+  int notify_write_fd{-1};
+
+  // intrusive lists of the operations, so that I/O threads never allocate
+  std::mutex pending_mutex;
+  std::condition_variable pending_cv;
+  FileIoOperation *pending_head{nullptr};
+  FileIoOperation *pending_tail{nullptr};
+  std::mutex finished_mutex;
+  FileIoOperation *finished_head{nullptr};
+
+  SignalSafeHashtable<int, OperationInfo> processing_operations;
+};
+} // namespace file_io_async
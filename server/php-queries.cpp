@@ -1130,6 +1130,9 @@ const char *net_event_t::get_description() const noexcept {
     [](const curl_async::CurlResponse *) {
       snprintf(BUF.data(), BUF.size(), "CURL_ASYNC_RESPONSE");
     },
+    [](const file_io_async::FileIoOperation *) {
+      snprintf(BUF.data(), BUF.size(), "FILE_IO_ASYNC_RESPONSE");
+    },
   }, data);
   return BUF.data();
 }
@@ -54,9 +54,14 @@ class CurlRequest;
 class CurlResponse;
 } // namespace curl_async
 
+namespace file_io_async {
+struct FileIoOperation;
+} // namespace file_io_async
+
 struct net_event_t {
   slot_id_t slot_id;
-  std::variant<net_events_data::rpc_answer, net_events_data::rpc_error, net_events_data::job_worker_answer, database_drivers::Response *, curl_async::CurlResponse *> data;
+  std::variant<net_events_data::rpc_answer, net_events_data::rpc_error, net_events_data::job_worker_answer, database_drivers::Response *, curl_async::CurlResponse *,
+               file_io_async::FileIoOperation *> data;
 
   const char *get_description() const noexcept;
 };
@@ -74,7 +79,8 @@ struct rpc_send {
 
 struct net_query_t {
   slot_id_t slot_id;
-  std::variant<net_queries_data::rpc_send, database_drivers::Request *, std::reference_wrapper<const curl_async::CurlRequest>> data;
+  std::variant<net_queries_data::rpc_send, database_drivers::Request *, std::reference_wrapper<const curl_async::CurlRequest>,
+               file_io_async::FileIoOperation *> data;
 };
 
 #pragma pack(push, 4)
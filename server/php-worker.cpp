@@ -17,6 +17,7 @@
 #include "server/curl-adaptor.h"
 #include "server/database-drivers/adaptor.h"
 #include "server/database-drivers/request.h"
+#include "server/file-io-adaptor.h"
 #include "server/job-workers/job-stats.h"
 #include "server/job-workers/job-worker-server.h"
 #include "server/php-engine.h"
@@ -205,6 +206,10 @@ void php_worker_run_net_queue(PhpWorker *worker __attribute__((unused))) {
                  [&](const curl_async::CurlRequest &request) {
                    php_assert(query->slot_id == request.request_id);
                    vk::singleton<curl_async::CurlAdaptor>::get().process_request_net_query(request);
+                 },
+                 [&](file_io_async::FileIoOperation *operation) {
+                   php_assert(query->slot_id == operation->request_id);
+                   vk::singleton<file_io_async::FileIoAdaptor>::get().process_operation_net_query(operation);
                  }},
                query->data);
   }
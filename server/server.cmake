@@ -3,6 +3,7 @@ prepend(KPHP_SERVER_SOURCES ${BASE_DIR}/server/
         confdata-binlog-replay.cpp
         confdata-stats.cpp
         curl-adaptor.cpp
+        file-io-adaptor.cpp
         shared-data.cpp
         http-server-context.cpp
         json-logger.cpp
@@ -17,6 +17,7 @@ SlotIdsFactory rpc_ids_factory;
 SlotIdsFactory parallel_job_ids_factory;
 SlotIdsFactory external_db_requests_factory;
 SlotIdsFactory curl_requests_factory;
+SlotIdsFactory file_io_requests_factory;
 
 
 void SlotIdsFactory::init() {
@@ -39,6 +40,7 @@ void init_slot_factories() {
   parallel_job_ids_factory.renew();
   external_db_requests_factory.renew();
   curl_requests_factory.renew();
+  file_io_requests_factory.renew();
 }
 
 void free_slot_factories() {
@@ -46,6 +48,7 @@ void free_slot_factories() {
   parallel_job_ids_factory.clear();
   external_db_requests_factory.clear();
   curl_requests_factory.clear();
+  file_io_requests_factory.clear();
 }
 
 void worker_global_init_slot_factories() {
@@ -53,4 +56,5 @@ void worker_global_init_slot_factories() {
   parallel_job_ids_factory.init();
   external_db_requests_factory.init();
   curl_requests_factory.init();
+  file_io_requests_factory.init();
 }
@@ -4,8 +4,8 @@
 
 #include "server/statshouse/statshouse-client.h"
 
-statshouse::TransportUDPBase::MetricBuilder StatsHouseClient::metric(std::string_view name, bool force_tag_host) {
-  auto builder = transport.metric(name);
+statshouse::Registry::MetricBuilder StatsHouseClient::metric(std::string_view name, bool force_tag_host) {
+  auto builder = registry.metric(name);
   builder.tag(tag_cluster);
   if (host_enabled || force_tag_host) {
     builder.tag("host", tag_host);
@@ -6,14 +6,32 @@
 
 #include "third-party/statshouse.h"
 
+/**
+ * Metrics are pre-aggregated by metric name and tags in the process (counters are summed up, values are collected),
+ * and the aggregated buckets are sent in packed batches by flush(), which is called from the cron once per second.
+ */
 class StatsHouseClient {
 public:
   // Safe to use dummy instance
-  StatsHouseClient() : transport({}, {}) {}
+  StatsHouseClient() : registry({}, {}) {
+    registry.disable_incremental_flush();
+  }
+
+  StatsHouseClient(const std::string &ip, int port) : registry(ip, port) {
+    registry.disable_incremental_flush();
+  }
 
-  StatsHouseClient(const std::string &ip, int port) : transport(ip, port) {}
+  statshouse::Registry::MetricBuilder metric(std::string_view name, bool force_tag_host = false);
 
-  statshouse::TransportUDPBase::MetricBuilder metric(std::string_view name, bool force_tag_host = false);
+  // a metric without the common tags, it's used for the application metrics
+  statshouse::Registry::MetricBuilder raw_metric(std::string_view name) {
+    return registry.metric(name);
+  }
+
+  // sends the buckets of the previous seconds, or all of them if force is set
+  void flush(bool force = false) {
+    registry.flush(force);
+  }
 
   void set_tag_cluster(std::string_view cluster) {
     tag_cluster = cluster;
@@ -32,7 +50,7 @@ public:
   }
 
 private:
-  statshouse::TransportUDP transport;
+  statshouse::Registry registry;
   std::string tag_cluster;
   std::string tag_host;
   bool host_enabled{false};
@@ -327,3 +327,34 @@ void StatsHouseManager::add_confdata_master_stats(const ConfdataStats &confdata_
     }
   }
 }
+
+statshouse::Registry::MetricBuilder StatsHouseManager::application_metric(const string &name, const array<string> &tags) {
+  auto builder = client.raw_metric({name.c_str(), name.size()});
+  for (const auto &it : tags) {
+    const string &value = it.get_value();
+    if (it.is_string_key()) {
+      const string &key = it.get_string_key();
+      builder.tag({key.c_str(), key.size()}, {value.c_str(), value.size()});
+    } else {
+      // an int key is the index of the tag, as tag names "0" ... "16" are the indexed tags ("0" is env)
+      const int64_t index = it.get_int_key();
+      if (index < 0 || index > statshouse::TransportUDPBase::MAX_KEYS) {
+        continue;
+      }
+      char key[4];
+      const int key_len = snprintf(key, sizeof(key), "%d", static_cast<int>(index));
+      builder.tag({key, static_cast<size_t>(key_len)}, {value.c_str(), value.size()});
+    }
+  }
+  return builder;
+}
+
+void StatsHouseManager::add_application_metric_count(const string &name, const array<string> &tags, double count) {
+  dl::CriticalSectionGuard guard; // It's called from script context
+  application_metric(name, tags).write_count(count);
+}
+
+void StatsHouseManager::add_application_metric_value(const string &name, const array<string> &tags, double value) {
+  dl::CriticalSectionGuard guard; // It's called from script context
+  application_metric(name, tags).write_value(value);
+}
@@ -37,6 +37,7 @@ public:
   void generic_cron() {
     generic_cron_check_if_tag_host_needed();
     set_common_tags();
+    client.flush();
   }
 
   /**
@@ -88,6 +89,12 @@ public:
 
   void add_confdata_master_stats(const ConfdataStats &confdata_stats);
 
+  /**
+   * Application metrics written from the script, int keys of tags are tag indices (so [2 => 'a'] sets tag 2), string keys are named tags
+   */
+  void add_application_metric_count(const string &name, const array<string> &tags, double count);
+  void add_application_metric_value(const string &name, const array<string> &tags, double value);
+
 private:
   StatsHouseClient client;
   bool need_write_enable_tag_host = false;
@@ -104,6 +111,8 @@ private:
 
   void generic_cron_check_if_tag_host_needed();
 
+  statshouse::Registry::MetricBuilder application_metric(const string &name, const array<string> &tags);
+
   void add_job_workers_shared_memory_stats(const job_workers::JobStats &job_stats);
 
   size_t add_job_workers_shared_messages_stats(const job_workers::JobStats::MemoryBufferStats &memory_buffers_stats,
@@ -0,0 +1,41 @@
+<?php
+
+class BenchmarkArrayLiterals {
+  /** @var int[] */
+  private $ids = [];
+  /** @var string[] */
+  private $names = [];
+
+  public function __construct() {
+    for ($i = 0; $i < 100; $i++) {
+      $this->ids[] = $i;
+      $this->names[] = "name$i";
+    }
+  }
+
+  public function benchmarkImplodeLiteral() {
+    $len = 0;
+    foreach ($this->ids as $i => $id) {
+      $len += strlen(implode(',', [$id, $this->names[$i], 'x']));
+    }
+    return $len;
+  }
+
+  public function benchmarkInArrayLiteral() {
+    $found = 0;
+    foreach ($this->ids as $id) {
+      if (in_array($id, [$found, $found + 1, $found * 2])) {
+        $found++;
+      }
+    }
+    return $found;
+  }
+
+  public function benchmarkMaxLiteral() {
+    $res = 0;
+    foreach ($this->ids as $id) {
+      $res += max([$id, $res % 7, 3]);
+    }
+    return $res;
+  }
+}
@@ -0,0 +1,48 @@
+<?php
+
+class BenchmarkArraySetOps {
+  /** @var int[] */
+  private $ids1 = [];
+  /** @var int[] */
+  private $ids2 = [];
+  /** @var string[] */
+  private $names1 = [];
+  /** @var string[] */
+  private $names2 = [];
+  /** @var mixed[] */
+  private $mixed = [];
+
+  public function __construct() {
+    for ($i = 0; $i < 10000; $i++) {
+      $this->ids1[] = $i * 3;
+      $this->ids2[] = $i * 5;
+      $this->names1[] = "name$i";
+      $this->names2[] = "name" . ($i * 2);
+      $this->mixed[] = $i % 3 ? $i % 1000 : (string)($i % 500);
+    }
+  }
+
+  public function benchmarkIntersectInts() {
+    return count(array_intersect($this->ids1, $this->ids2));
+  }
+
+  public function benchmarkDiffInts() {
+    return count(array_diff($this->ids1, $this->ids2));
+  }
+
+  public function benchmarkUniqueInts() {
+    return count(array_unique(array_merge($this->ids1, $this->ids2)));
+  }
+
+  public function benchmarkIntersectStrings() {
+    return count(array_intersect($this->names1, $this->names2));
+  }
+
+  public function benchmarkUniqueMixed() {
+    return count(array_unique($this->mixed));
+  }
+
+  public function benchmarkCountValuesInts() {
+    return count(array_count_values($this->ids1));
+  }
+}
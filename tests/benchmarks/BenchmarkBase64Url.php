@@ -0,0 +1,43 @@
+<?php
+
+class BenchmarkBase64Url {
+  private $binary = '';
+  private $encoded = '';
+  private $encoded_lines = '';
+  private $query = '';
+  private $path = '';
+
+  public function __construct() {
+    for ($i = 0; $i < 3000; $i++) {
+      $this->binary .= chr(($i * 73 + 11) % 256);
+    }
+    $this->encoded = base64_encode($this->binary);
+    $this->encoded_lines = chunk_split($this->encoded, 76, "\r\n");
+    $this->query = str_repeat('name=John Smith&city=Saint-Petersburg&q=кошки и собаки&', 20);
+    $this->path = str_repeat('static/images/user_avatars/2023-05-17/photo_1234567890.jpg/', 20);
+  }
+
+  public function benchmarkBase64Encode() {
+    return base64_encode($this->binary);
+  }
+
+  public function benchmarkBase64Decode() {
+    return base64_decode($this->encoded);
+  }
+
+  public function benchmarkBase64DecodeStrict() {
+    return base64_decode($this->encoded, true);
+  }
+
+  public function benchmarkBase64DecodeLines() {
+    return base64_decode($this->encoded_lines, true);
+  }
+
+  public function benchmarkUrlencodeQuery() {
+    return urlencode($this->query);
+  }
+
+  public function benchmarkRawurlencodePath() {
+    return rawurlencode($this->path);
+  }
+}
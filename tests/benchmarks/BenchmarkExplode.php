@@ -65,4 +65,11 @@ class BenchmarkExplode {
     [$y1, $y2, $y3, $y4] = explode($this->delim, $this->words8, 10);
     return strlen($x1) + strlen($x2) + strlen($x3) + strlen($x4) + strlen($y1) + strlen($y2) + strlen($y3) + strlen($y4);
   }
+
+  public function benchmarkExplodeNthAsTmpString() {
+    $x = (int)explode(' ', '10 20 30 40')[2];
+    $key = 'k' . explode($this->delim, $this->words8)[3];
+    $y = trim(explode(',', ' a , b ,c')[1]);
+    return $x + strlen($key) + strlen($y);
+  }
 }
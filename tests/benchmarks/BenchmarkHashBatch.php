@@ -0,0 +1,63 @@
+<?php
+
+#ifndef KPHP
+function md5_batch(array $strs, bool $raw_output = false) {
+  return array_map(function ($s) use ($raw_output) { return md5($s, $raw_output); }, $strs);
+}
+function sha1_batch(array $strs, bool $raw_output = false) {
+  return array_map(function ($s) use ($raw_output) { return sha1($s, $raw_output); }, $strs);
+}
+function crc32_batch(array $strs) {
+  return array_map('crc32', $strs);
+}
+function xxh3_64(string $s) {
+  return unpack('J', hash('xxh3', $s, true))[1];
+}
+#endif
+
+class BenchmarkHashBatch {
+  /** @var string[] */
+  private $keys = [];
+
+  public function __construct() {
+    for ($i = 0; $i < 1000; $i++) {
+      $this->keys[] = "user_profile:" . ($i * 7919) . ":friends";
+    }
+  }
+
+  public function benchmarkMd5Loop() {
+    $result = [];
+    foreach ($this->keys as $key) {
+      $result[] = md5($key);
+    }
+    return $result;
+  }
+
+  public function benchmarkMd5Batch() {
+    return md5_batch($this->keys);
+  }
+
+  public function benchmarkSha1Loop() {
+    $result = [];
+    foreach ($this->keys as $key) {
+      $result[] = sha1($key);
+    }
+    return $result;
+  }
+
+  public function benchmarkSha1Batch() {
+    return sha1_batch($this->keys);
+  }
+
+  public function benchmarkCrc32Batch() {
+    return crc32_batch($this->keys);
+  }
+
+  public function benchmarkXxh3Shards() {
+    $shards = [];
+    foreach ($this->keys as $key) {
+      $shards[] = xxh3_64($key) & 1023;
+    }
+    return $shards;
+  }
+}
@@ -0,0 +1,49 @@
+<?php
+
+class BenchmarkListArrays {
+  /** @var int[] */
+  private $ints = [];
+
+  public function __construct() {
+    for ($i = 0; $i < 1000; $i++) {
+      $this->ints[] = $i;
+    }
+  }
+
+  public function benchmarkForeachList() {
+    $list = [];
+    foreach ($this->ints as $x) {
+      $list[] = $x * 3;
+    }
+    $sum = 0;
+    foreach ($list as $i => $x) {
+      $sum += $x ^ $i;
+    }
+    return $sum;
+  }
+
+  public function benchmarkIndexList() {
+    $list = [];
+    foreach ($this->ints as $x) {
+      $list[] = $x + 1;
+    }
+    $sum = 0;
+    $n = count($list);
+    for ($i = 0; $i < $n; $i++) {
+      $sum += $list[$i];
+    }
+    return $sum;
+  }
+
+  public function benchmarkForeachMap() {
+    $map = [];
+    foreach ($this->ints as $x) {
+      $map[$x] = $x * 3;
+    }
+    $sum = 0;
+    foreach ($map as $i => $x) {
+      $sum += $x ^ $i;
+    }
+    return $sum;
+  }
+}
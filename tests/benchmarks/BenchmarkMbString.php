@@ -0,0 +1,41 @@
+<?php
+
+class BenchmarkMbString {
+  private $ascii = '';
+  private $cyrillic = '';
+  private $mixed = '';
+
+  public function __construct() {
+    $this->ascii = str_repeat('The quick brown fox jumps over the lazy dog. ', 40);
+    $this->cyrillic = str_repeat('Съешь же ещё этих мягких французских булок, да выпей чаю. ', 40);
+    $this->mixed = str_repeat('Hello, мир! Some ascii text between words. ', 40);
+  }
+
+  public function benchmarkStrlenAscii() {
+    return mb_strlen($this->ascii, 'UTF-8');
+  }
+
+  public function benchmarkStrlenCyrillic() {
+    return mb_strlen($this->cyrillic, 'UTF-8');
+  }
+
+  public function benchmarkSubstrMixed() {
+    return mb_substr($this->mixed, 500, 100, 'UTF-8');
+  }
+
+  public function benchmarkStrposMixed() {
+    return mb_strpos($this->mixed, 'words. Hello', 1000, 'UTF-8');
+  }
+
+  public function benchmarkCheckEncodingAscii() {
+    return mb_check_encoding($this->ascii, 'UTF-8');
+  }
+
+  public function benchmarkStrtolowerMixed() {
+    return mb_strtolower($this->mixed, 'UTF-8');
+  }
+
+  public function benchmarkStrtoupperAscii() {
+    return mb_strtoupper($this->ascii, 'UTF-8');
+  }
+}
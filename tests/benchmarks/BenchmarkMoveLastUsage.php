@@ -0,0 +1,44 @@
+<?php
+
+class BenchmarkMoveLastUsage {
+  private $items = [];
+
+  /** @param int[] $arr */
+  private static function appendOne(array $arr): array {
+    $arr[] = 1;
+    return $arr;
+  }
+
+  /** @param string[] $arr */
+  private static function appendString(array $arr, string $s): array {
+    $arr[] = $s;
+    return $arr;
+  }
+
+  /** @param int[] $arr */
+  private function store(array $arr) {
+    $this->items = $arr;
+  }
+
+  public function benchmarkReassignFromCall() {
+    $arr = [];
+    for ($i = 0; $i < 100; $i++) {
+      $arr = self::appendOne($arr);
+    }
+    return count($arr);
+  }
+
+  public function benchmarkReassignStringsFromCall() {
+    $arr = [];
+    for ($i = 0; $i < 100; $i++) {
+      $arr = self::appendString($arr, 'item');
+    }
+    return count($arr);
+  }
+
+  public function benchmarkStoreToField() {
+    $arr = range(0, 100);
+    $this->store($arr);
+    return count($this->items);
+  }
+}
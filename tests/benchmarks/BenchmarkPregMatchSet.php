@@ -0,0 +1,43 @@
+<?php
+
+#ifndef KPHP
+function preg_match_set(array $patterns, string $subject) {
+  $result = [];
+  $position = 0;
+  foreach ($patterns as $pattern) {
+    if (preg_match($pattern, $subject)) {
+      $result[] = $position;
+    }
+    $position++;
+  }
+  return $result;
+}
+#endif
+
+class BenchmarkPregMatchSet {
+  /** @var string[] */
+  private $patterns = [];
+  private $subject = 'GET /api/v2/users/12345/friends?offset=100&count=50 HTTP/1.1';
+
+  public function __construct() {
+    foreach (['users', 'friends', 'groups', 'wall', 'photos', 'video', 'audio', 'messages', 'docs', 'market'] as $section) {
+      $this->patterns[] = "~^GET /api/v\\d+/$section/\\d+~";
+      $this->patterns[] = "~/$section\\?.*count=\\d+~";
+      $this->patterns[] = "~^POST /api/v\\d+/$section~i";
+    }
+  }
+
+  public function benchmarkSequentialPregMatch() {
+    $result = [];
+    foreach ($this->patterns as $i => $pattern) {
+      if (preg_match($pattern, $this->subject)) {
+        $result[] = $i;
+      }
+    }
+    return $result;
+  }
+
+  public function benchmarkPregMatchSet() {
+    return preg_match_set($this->patterns, $this->subject);
+  }
+}
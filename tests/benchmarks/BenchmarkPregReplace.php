@@ -0,0 +1,23 @@
+<?php
+
+class BenchmarkPregReplace {
+  private $doc = '';
+
+  public function __construct() {
+    $this->doc = str_repeat("id=12345; name=John Smith; email=john@example.com; ", 500);
+  }
+
+  public function benchmarkReplaceTemplate() {
+    return preg_replace('/(\w+)=([^;]*)/', '$1: "${2}"', $this->doc);
+  }
+
+  public function benchmarkReplaceCallback() {
+    return preg_replace_callback('/(\w+)=([^;]*)/', function ($m) {
+      return $m[1] . ': ' . strlen($m[2]);
+    }, $this->doc);
+  }
+
+  public function benchmarkSplit() {
+    return preg_split('/;\s*/', $this->doc, -1, PREG_SPLIT_NO_EMPTY);
+  }
+}
@@ -0,0 +1,35 @@
+<?php
+
+class BenchmarkSprintf {
+  private $id = 1234567;
+  private $price = 1499.5;
+  private $name = 'Lorem ipsum dolor sit amet';
+
+  public function benchmarkSimple() {
+    return sprintf("user %d: %s", $this->id, $this->name);
+  }
+
+  public function benchmarkPaddedInt() {
+    return sprintf("%08d", $this->id);
+  }
+
+  public function benchmarkHex() {
+    return sprintf("%08x-%04X", $this->id, $this->id & 0xffff);
+  }
+
+  public function benchmarkFloatPrecision() {
+    return sprintf("%.2f", $this->price);
+  }
+
+  public function benchmarkMixedSpecifiers() {
+    return sprintf("[%-10s] #%06d %10.3f%%", $this->name, $this->id, $this->price);
+  }
+
+  public function benchmarkTruncatedString() {
+    return sprintf("%.10s...", $this->name);
+  }
+
+  public function benchmarkDate() {
+    return vsprintf("%04d-%02d-%02d", [2023, 5, 7]);
+  }
+}
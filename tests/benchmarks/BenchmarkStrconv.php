@@ -6,6 +6,10 @@ class BenchmarkStrconv {
   /** @var mixed */
   private $mixed = 'hello';
   private $map = [];
+  private $price = 1499.95;
+  private $ratio = 0.1 + 0.2;
+  private $price_str = '1499.95';
+  private $numeric_str = '18446744';
 
   public function __construct() {
     $this->map = [
@@ -45,4 +49,24 @@ class BenchmarkStrconv {
     $i = 54543937;
     return (string)$i . $this->mixed;
   }
+
+  public function benchmarkStrvalFloatShort() {
+    return strval($this->price);
+  }
+
+  public function benchmarkStrvalFloatLong() {
+    return strval($this->ratio);
+  }
+
+  public function benchmarkFloatvalString() {
+    return floatval($this->price_str);
+  }
+
+  public function benchmarkCompareNumericStrings() {
+    return $this->price_str == $this->numeric_str;
+  }
+
+  public function benchmarkJsonDecodeFloats() {
+    return json_decode('[1.5, 2.25, 1499.95, 0.001, 123456.789]');
+  }
 }
@@ -0,0 +1,54 @@
+<?php
+
+#ifndef KPHP
+function vk_array_add(array $a, array $b) {
+  return array_map(function ($x, $y) { return $x + $y; }, $a, $b);
+}
+function vk_array_mul(array $a, array $b) {
+  return array_map(function ($x, $y) { return $x * $y; }, $a, $b);
+}
+function vk_array_scale(array $a, float $k) {
+  return array_map(function ($x) use ($k) { return $x * $k; }, $a);
+}
+#endif
+
+class BenchmarkVectorMath {
+  /** @var int[] */
+  private $ints = [];
+  /** @var float[] */
+  private $features = [];
+  /** @var float[] */
+  private $weights = [];
+
+  public function __construct() {
+    for ($i = 0; $i < 1000; $i++) {
+      $this->ints[] = ($i * 7919) % 1009;
+      $this->features[] = (($i * 31) % 97) / 97;
+      $this->weights[] = (($i * 17) % 89) / 89 - 0.5;
+    }
+  }
+
+  public function benchmarkIntSum() {
+    return array_sum($this->ints);
+  }
+
+  public function benchmarkIntMinMax() {
+    return max($this->ints) - min($this->ints);
+  }
+
+  public function benchmarkFloatMinMax() {
+    return max($this->features) - min($this->features);
+  }
+
+  public function benchmarkMapMul() {
+    return array_map(function ($x, $y) { return $x * $y; }, $this->features, $this->weights);
+  }
+
+  public function benchmarkVectorMul() {
+    return vk_array_mul($this->features, $this->weights);
+  }
+
+  public function benchmarkVectorScaleAdd() {
+    return vk_array_add(vk_array_scale($this->features, 0.5), $this->weights);
+  }
+}
@@ -0,0 +1,144 @@
+#!/usr/bin/python3
+import argparse
+import os
+import random
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+from python.lib.colors import red, green, blue
+from python.lib.file_utils import search_kphp2cpp
+
+# generates a synthetic project, which looks like a large real one from the type inferring point of view:
+# a lot of classes and functions, with long call chains across files, untyped params and mixed arrays,
+# so that types are propagated through the whole call graph;
+# then transpiles it with different --threads-count and prints the timings of the pipes
+
+
+def gen_class(out, module, n_methods, n_modules, rnd):
+    out.write("class M{}_Entity {{\n".format(module))
+    out.write("  public $id = 0;\n")
+    out.write("  public $name = '';\n")
+    out.write("  public $tags = [];\n")
+    out.write("  public $extra = [];\n\n")
+    for m in range(n_methods):
+        callee_module = rnd.randrange(n_modules)
+        callee_method = rnd.randrange(n_methods)
+        out.write("  public function method{}($x, $y) {{\n".format(m))
+        out.write("    $row = ['id' => $this->id, 'name' => $this->name, 'x' => $x];\n")
+        out.write("    $this->tags[] = $y;\n")
+        out.write("    $this->extra[$this->name] = $row;\n")
+        if m + 1 < n_methods:
+            out.write("    $r = $this->method{}($x + 1, (string)$y);\n".format(m + 1))
+        else:
+            out.write("    $r = [$x, $y];\n")
+        if callee_module != module:
+            out.write("    $r[] = m{}_func{}($row, $x);\n".format(callee_module, callee_method))
+        out.write("    return $r;\n")
+        out.write("  }\n\n")
+    out.write("}\n\n")
+
+
+def gen_functions(out, module, n_functions, n_modules, rnd):
+    for f in range(n_functions):
+        callee_module = rnd.randrange(n_modules)
+        out.write("function m{}_func{}($arr, $k) {{\n".format(module, f))
+        out.write("  $res = [];\n")
+        out.write("  foreach ($arr as $key => $value) {\n")
+        out.write("    $res[$key . '_' . $k] = $value;\n")
+        out.write("  }\n")
+        if f + 1 < n_functions:
+            out.write("  $res['next'] = m{}_func{}($res, $k);\n".format(module, f + 1))
+        if callee_module != module and rnd.random() < 0.5:
+            out.write("  $e = new M{}_Entity;\n".format(callee_module))
+            out.write("  $res['entity'] = $e->method0($k, $k);\n")
+        out.write("  return $res;\n")
+        out.write("}\n\n")
+
+
+def generate_project(project_dir, n_modules, n_functions, n_methods, seed):
+    rnd = random.Random(seed)
+    for module in range(n_modules):
+        with open(os.path.join(project_dir, "module{}.php".format(module)), "w") as out:
+            out.write("<?php\n\n")
+            gen_class(out, module, n_methods, n_modules, rnd)
+            gen_functions(out, module, n_functions, n_modules, rnd)
+
+    index_php = os.path.join(project_dir, "index.php")
+    with open(index_php, "w") as out:
+        out.write("<?php\n\n")
+        for module in range(n_modules):
+            out.write("require_once 'module{}.php';\n".format(module))
+        out.write("\n")
+        for module in range(n_modules):
+            out.write("var_dump(m{}_func0(['a' => 1], {}));\n".format(module, module))
+    return index_php
+
+
+def read_metrics(metrics_file):
+    metrics = {}
+    with open(metrics_file) as f:
+        for line in f:
+            key, _, value = line.partition(":")
+            if value.strip():
+                metrics[key.strip()] = value.strip()
+    return metrics
+
+
+def run_kphp(kphp_path, index_php, dest_dir, threads_count):
+    metrics_file = os.path.join(dest_dir, "metrics.txt")
+    cmd = [kphp_path, "--no-make", "-t", str(threads_count), "-d", dest_dir,
+           "--compilation-metrics-file", metrics_file, index_php]
+    start = time.time()
+    proc = subprocess.run(cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+    elapsed = time.time() - start
+    if proc.returncode != 0:
+        print(red("kphp2cpp failed with -t {}:".format(threads_count)))
+        print(proc.stderr.decode(errors="replace"))
+        sys.exit(1)
+    return elapsed, read_metrics(metrics_file)
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+    parser.add_argument("--modules", type=int, default=500, help="number of generated files, one class in each")
+    parser.add_argument("--functions", type=int, default=40, help="number of functions in each file")
+    parser.add_argument("--methods", type=int, default=20, help="number of methods in each class")
+    parser.add_argument("--seed", type=int, default=1, help="random seed of the call graph")
+    parser.add_argument("--threads", type=str, default="1,4,8,16,32", help="comma-separated thread counts to compare")
+    parser.add_argument("--keep", action="store_true", default=False, help="don't remove the generated project")
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+    kphp_path = os.path.abspath(search_kphp2cpp())
+    work_dir = tempfile.mkdtemp(prefix="kphp_compile_time_")
+    project_dir = os.path.join(work_dir, "project")
+    os.mkdir(project_dir)
+
+    index_php = generate_project(project_dir, args.modules, args.functions, args.methods, args.seed)
+    print(blue("Generated {} files with {} functions in {}".format(
+        args.modules, args.modules * (args.functions + args.methods), project_dir)))
+
+    for threads_count in [int(t) for t in args.threads.split(",")]:
+        dest_dir = os.path.join(work_dir, "out_t{}".format(threads_count))
+        elapsed, metrics = run_kphp(kphp_path, index_php, dest_dir, threads_count)
+        print(green("-t {:<3}".format(threads_count)) +
+              " total: {:.2f}s, transpilation: {}s, type inferring: {}s (working time {}s), split tasks: {}".format(
+                  elapsed,
+                  metrics.get("compilation.transpilation_time", "?"),
+                  metrics.get("pipes.Type_Inferring.duration", "?"),
+                  metrics.get("pipes.Type_Inferring.working_time", "?"),
+                  metrics.get("types.inferring_split_tasks", "?")))
+
+    if args.keep:
+        print("Project is kept in {}".format(work_dir))
+    else:
+        shutil.rmtree(work_dir)
+
+
+if __name__ == "__main__":
+    main()
@@ -5,6 +5,7 @@ prepend(COMPILER_TESTS_SOURCES ${BASE_DIR}/tests/cpp/compiler/
         typedata-test.cpp
         lexer-test.cpp
         ffi-parser-test.cpp
+        function-profile-test.cpp
         utils/string-utils-test.cpp)
 
 vk_add_unittest(compiler "${COMPILER_LIBS}" ${COMPILER_TESTS_SOURCES})
@@ -0,0 +1,85 @@
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+
+#include "compiler/function-profile.h"
+
+using hotness = FunctionData::profile_hotness_t;
+
+static FunctionProfile load_profile(const std::string &content) {
+  const std::string file_name = testing::TempDir() + "function-profile-test.callgrind";
+  std::ofstream{file_name} << content;
+  FunctionProfile profile;
+  profile.load_from(file_name);
+  std::remove(file_name.c_str());
+  return profile;
+}
+
+// main makes 99995 calls: hot() makes 90% of them, rare() makes less than 0.01% of them
+static const std::string profile_content =
+  "events: Calls\n"
+  "fn=main\n"
+  "cfn=hot\n"
+  "calls=90000 12\n"
+  "cfn=middle (label)\n"
+  "calls=9990 13\n"
+  "cfn=rare\n"
+  "calls=5 14\n"
+  "fn=hot\n"
+  "fn=middle (label)\n"
+  "fn=rare\n";
+
+TEST(function_profile_test, test_empty_file) {
+  const FunctionProfile profile = load_profile("");
+  ASSERT_TRUE(profile.empty());
+  ASSERT_EQ(profile.get_hotness("main"), hotness::unknown);
+}
+
+TEST(function_profile_test, test_hot_and_cold) {
+  const FunctionProfile profile = load_profile(profile_content);
+  ASSERT_FALSE(profile.empty());
+  ASSERT_EQ(profile.get_hotness("hot"), hotness::hot);
+  ASSERT_EQ(profile.get_hotness("middle"), hotness::unknown);
+  ASSERT_EQ(profile.get_hotness("rare"), hotness::cold);
+  // a root has no callers, it is not cold
+  ASSERT_EQ(profile.get_hotness("main"), hotness::unknown);
+}
+
+TEST(function_profile_test, test_unknown_functions) {
+  const FunctionProfile profile = load_profile(profile_content);
+  ASSERT_EQ(profile.get_hotness("not_profiled"), hotness::unknown);
+  ASSERT_EQ(profile.get_hotness("middle (label)"), hotness::unknown);
+  ASSERT_EQ(profile.get_hotness(""), hotness::unknown);
+}
+
+TEST(function_profile_test, test_duplicate_entries) {
+  // several concatenated files: the calls are summed up, so rare() is not cold anymore
+  std::string rare_called_often = "fn=main\ncfn=rare\ncalls=10 1\n";
+  const FunctionProfile profile = load_profile(profile_content + rare_called_often + profile_content);
+  ASSERT_EQ(profile.get_hotness("hot"), hotness::hot);
+  ASSERT_EQ(profile.get_hotness("rare"), hotness::unknown);
+  ASSERT_EQ(profile.get_hotness("middle"), hotness::unknown);
+}
+
+TEST(function_profile_test, test_malformed_lines) {
+  const FunctionProfile profile = load_profile(
+    "calls=100 1\n"          // no cfn= before, skipped
+    "fn=main\n"
+    "garbage line\n"
+    "cfn=\n"
+    "calls=100000 1\n"       // empty callee, skipped
+    "cfn=hot\n"
+    "calls=90000 1\n"
+    "calls=-1 1\n"           // not a number, skipped
+    "calls=abc\n"
+    "calls=\n"
+    "cfn=rare\n"
+    "calls=5\n"
+    "cfn=middle\n"
+    "calls=9990\n"
+    "fn=");
+  ASSERT_EQ(profile.get_hotness("hot"), hotness::hot);
+  ASSERT_EQ(profile.get_hotness("middle"), hotness::unknown);
+  ASSERT_EQ(profile.get_hotness("rare"), hotness::cold);
+  ASSERT_EQ(profile.get_hotness(""), hotness::unknown);
+}
@@ -132,3 +132,39 @@ TEST(array_test, test_mutate_shared_map) {
   ASSERT_EQ(arr_copy.get_reference_counter(), 1);
   ASSERT_FALSE(arr_copy.is_equal_inner_pointer(arr));
 }
+
+TEST(array_test, test_refill_vector) {
+  array<string> arr;
+  arr.refill_vector(string{"a"}, string{"b"}, string{"c"});
+  ASSERT_TRUE(arr.is_vector());
+  ASSERT_EQ(arr.count(), 3);
+  ASSERT_EQ(arr.get_reference_counter(), 1);
+
+  // not shared and big enough: the same buffer is refilled
+  const string *buffer = arr.find_value(0);
+  arr.refill_vector(string{"d"}, string{"e"});
+  ASSERT_EQ(arr.find_value(0), buffer);
+  ASSERT_EQ(arr.count(), 2);
+  ASSERT_EQ(arr.get_value(0), string{"d"});
+  ASSERT_EQ(arr.get_value(1), string{"e"});
+
+  // shared: the copy must stay untouched
+  const auto arr_copy = arr;
+  arr.refill_vector(string{"f"});
+  ASSERT_FALSE(arr.is_equal_inner_pointer(arr_copy));
+  ASSERT_EQ(arr.count(), 1);
+  ASSERT_EQ(arr.get_value(0), string{"f"});
+  ASSERT_EQ(arr_copy.count(), 2);
+  ASSERT_EQ(arr_copy.get_value(0), string{"d"});
+}
+
+TEST(array_test, test_get_list_value) {
+  array<int64_t> arr;
+  ASSERT_EQ(arr.get_list_value(0), 0);
+  arr.push_back(10);
+  arr.push_back(20);
+  ASSERT_EQ(arr.get_list_value(0), 10);
+  ASSERT_EQ(arr.get_list_value(1), 20);
+  ASSERT_EQ(arr.get_list_value(2), 0);
+  ASSERT_EQ(arr.get_list_value(-1), 0);
+}
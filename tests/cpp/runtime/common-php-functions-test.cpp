@@ -1,3 +1,5 @@
+#include <random>
+
 #include <gtest/gtest.h>
 
 #include "common/php-functions.h"
@@ -147,3 +149,19 @@ TEST(test_php_try_to_integer, long_strings) {
   ASSERT_FALSE(php_try_to_int_wrapper("-784894841981984984891498", x));
   ASSERT_FALSE(php_try_to_int_wrapper("-9223372036854775809", x));
 }
+
+TEST(test_php_try_to_integer, random_strings) {
+  std::mt19937_64 gen{42};
+  for (int i = 0; i < 100000; ++i) {
+    const auto expected = static_cast<int64_t>(gen() >> (gen() % 64));
+    std::string s = std::to_string(gen() % 2 ? expected : -expected);
+    int64_t x = 0;
+    ASSERT_TRUE(php_try_to_int_wrapper(s, x)) << s;
+    ASSERT_EQ(std::to_string(x), s);
+    ASSERT_TRUE(php_is_int_wrapper(s)) << s;
+
+    s[gen() % s.size()] = "x .e/:"[gen() % 6];
+    ASSERT_FALSE(php_try_to_int_wrapper(s, x)) << s;
+    ASSERT_FALSE(php_is_int_wrapper(s)) << s;
+  }
+}
@@ -122,6 +122,22 @@ TEST(confdata_functions_test, test_confdata_get_values_by_any_wildcard) {
   }));
 }
 
+TEST(confdata_functions_test, test_confdata_get_values_by_any_wildcard_cached) {
+  init_global_confdata_confdata();
+
+  for (auto wildcard: {"_key", "_two dot.a.t", "_two"}) {
+    const auto first_result = f$confdata_get_values_by_any_wildcard(string{wildcard});
+    const auto second_result = f$confdata_get_values_by_any_wildcard(string{wildcard});
+    ASSERT_TRUE(equals(first_result, second_result));
+    ASSERT_TRUE(second_result.is_reference_counter(ExtraRefCnt::for_confdata));
+  }
+
+  auto result = f$confdata_get_values_by_any_wildcard(string{"_key"});
+  result.set_value(string{"_3"}, string{"value_3"});
+  ASSERT_EQ(result.count(), 3);
+  ASSERT_EQ(f$confdata_get_values_by_any_wildcard(string{"_key"}).count(), 2);
+}
+
 TEST(confdata_functions_test, test_confdata_get_values_by_bad_wildcard) {
   init_global_confdata_confdata();
 
@@ -2,6 +2,7 @@ prepend(SERVER_TESTS_SOURCES ${BASE_DIR}/tests/cpp/server/
         job-workers/shared-memory-manager-test.cpp
         master-name-test.cpp
         server-config-test.cpp
+        statshouse-client-test.cpp
         confdata-binlog-events-test.cpp
         php-engine-test.cpp
         workers-control-test.cpp)
@@ -0,0 +1,78 @@
+#include <arpa/inet.h>
+#include <cstring>
+#include <numeric>
+#include <vector>
+#include <gtest/gtest.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "server/statshouse/statshouse-client.h"
+
+namespace {
+
+class UdpReceiver {
+public:
+  UdpReceiver() {
+    fd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addr_len = sizeof(addr);
+    bind(fd, reinterpret_cast<sockaddr *>(&addr), addr_len);
+    getsockname(fd, reinterpret_cast<sockaddr *>(&addr), &addr_len);
+    port = ntohs(addr.sin_port);
+  }
+
+  ~UdpReceiver() {
+    close(fd);
+  }
+
+  // returns the number of metrics in each received datagram
+  std::vector<uint32_t> receive_batches() const {
+    std::vector<uint32_t> batches;
+    std::vector<char> buf(65536);
+    ssize_t len = 0;
+    while ((len = recv(fd, buf.data(), buf.size(), MSG_DONTWAIT)) > 0) {
+      uint32_t batch_size = 0;
+      EXPECT_GE(len, 12);
+      std::memcpy(&batch_size, buf.data() + 8, sizeof(batch_size)); // TL tag, fields mask, batch size
+      batches.push_back(batch_size);
+    }
+    return batches;
+  }
+
+  int fd{-1};
+  int port{0};
+};
+
+} // namespace
+
+TEST(statshouse_client_test, test_aggregation) {
+  UdpReceiver receiver;
+  {
+    StatsHouseClient client{"127.0.0.1", receiver.port};
+    client.set_tag_cluster("test_cluster");
+
+    for (int i = 0; i < 1000; ++i) {
+      client.metric("test_request_time").tag("http").write_value(i);
+      client.metric("test_request_errors").tag("http").write_count(1);
+      client.raw_metric("test_app_metric").tag("app").write_count(2);
+    }
+    // nothing is sent until flush
+    ASSERT_TRUE(receiver.receive_batches().empty());
+    client.flush(true);
+  }
+
+  // the transport may send the first metric right away and keeps the rest until the packet is full or the client is destroyed
+  const auto batches = receiver.receive_batches();
+  ASSERT_GE(batches.size(), 1);
+  ASSERT_LE(batches.size(), 2);
+  ASSERT_EQ(std::accumulate(batches.begin(), batches.end(), 0u), 3);
+}
+
+TEST(statshouse_client_test, test_dummy_instance) {
+  StatsHouseClient client;
+  client.metric("test_request_time").tag("http").write_value(1);
+  client.flush(true);
+}
@@ -0,0 +1,53 @@
+@ok
+<?php
+
+/**
+ * @param int[] $a
+ * @param int[] $b
+ */
+function test_ints($a, $b) {
+  var_dump(array_intersect($a, $b));
+  var_dump(array_diff($a, $b));
+  var_dump(array_unique($a));
+  var_dump(array_count_values($a));
+}
+
+/**
+ * @param int[] $a
+ * @param string[] $b
+ */
+function test_ints_and_strings($a, $b) {
+  var_dump(array_intersect($a, $b));
+  var_dump(array_intersect($b, $a));
+  var_dump(array_diff($a, $b));
+  var_dump(array_diff($b, $a));
+}
+
+/**
+ * @param mixed[] $a
+ * @param mixed[] $b
+ */
+function test_mixed($a, $b) {
+  var_dump(array_intersect($a, $b));
+  var_dump(array_diff($a, $b));
+  var_dump(array_unique($a));
+  var_dump(array_unique($b));
+}
+
+/**
+ * @param float[] $a
+ * @param mixed[] $b
+ */
+function test_floats($a, $b) {
+  var_dump(array_intersect($a, $b));
+  var_dump(array_diff($a, $b));
+  var_dump(array_unique($a));
+}
+
+test_ints([1, 2, 3, 4, 5, 2, -1, 0], [2, 4, 6, -1]);
+test_ints(['a' => 10, 'b' => 20, 'c' => 10], [10]);
+test_ints([], [1, 2]);
+test_ints_and_strings([1, 2, 3, 10, -5, 0], ['1', '02', '3 ', '10', '-5', '', '0', '-0']);
+test_mixed([1, '1', true, false, null, '', 0, '0', 'abc', 1.5, '1.5', -0], [true, null, '01', 'abc', 1.50, 0]);
+test_mixed(['x' => 7, 'y' => '7', 'z' => 7.0], ['7.0', false]);
+test_floats([1.0, 1.5, 0.1 + 0.2, 0.3, 2.0], ['1', 0.3, '1.5', '2']);
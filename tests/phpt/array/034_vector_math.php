@@ -0,0 +1,80 @@
+@ok
+<?php
+
+#ifndef KPHP
+function vk_dot_product(array $a, array $b) {
+  $result = 0;
+  foreach ($a as $k => $x) {
+    $result += $x * $b[$k];
+  }
+  return $result;
+}
+function vk_array_add(array $a, array $b) {
+  return array_map(function ($x, $y) { return (float)$x + (float)$y; }, array_values($a), array_values($b));
+}
+function vk_array_sub(array $a, array $b) {
+  return array_map(function ($x, $y) { return (float)$x - (float)$y; }, array_values($a), array_values($b));
+}
+function vk_array_mul(array $a, array $b) {
+  return array_map(function ($x, $y) { return (float)$x * (float)$y; }, array_values($a), array_values($b));
+}
+function vk_array_scale(array $a, float $k) {
+  return array_map(function ($x) use ($k) { return (float)$x * $k; }, array_values($a));
+}
+#endif
+
+/** @param int[] $a */
+function test_ints($a) {
+  var_dump(array_sum($a));
+  var_dump(min($a));
+  var_dump(max($a));
+  var_dump(vk_dot_product($a, $a));
+}
+
+/** @param float[] $a */
+function test_floats($a) {
+  var_dump(array_sum($a));
+  var_dump(min($a));
+  var_dump(max($a));
+}
+
+function test_aggregates() {
+  $ints = [];
+  for ($i = 0; $i < 37; $i++) {
+    $ints[] = ($i * 7919) % 101 - 50;
+  }
+  test_ints($ints);
+  test_ints([5]);
+  test_ints([3, -2, 3, -2, 9, 9, 1, 0, -7, 4, 4, 4, 4, 4, -7, 8]);
+  test_ints([10 => 1, 20 => -5, 30 => 7]);
+
+  $floats = [];
+  for ($i = 0; $i < 41; $i++) {
+    $floats[] = (($i * 31) % 17 - 8) / 4;
+  }
+  test_floats($floats);
+  test_floats([1e16, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0, -1e16]);
+  test_floats([0.0, -0.0, 0.0, -0.0, 0.0, -0.0, 0.0, -0.0, 0.0, -0.0]);
+  test_floats([-0.0, 0.0, 1.0, 0.0, -0.0, 2.0, 0.0, -1.0, -0.0, 0.0, 0.0]);
+  test_floats(['a' => 2.5, 'b' => -1.5, 'c' => 0.25]);
+}
+
+function test_element_wise() {
+  $a = [];
+  $b = [];
+  for ($i = 0; $i < 11; $i++) {
+    $a[] = $i / 2;
+    $b[] = 3 - $i * 0.25;
+  }
+  var_dump(vk_array_add($a, $b));
+  var_dump(vk_array_sub($a, $b));
+  var_dump(vk_array_mul($a, $b));
+  var_dump(vk_array_scale($a, -1.5));
+  var_dump(vk_array_scale([], 2.0));
+  var_dump(vk_array_add([], []));
+  var_dump(vk_array_add(['x' => 1.5, 'y' => 2.5], [10 => 0.5, 20 => 0.25]));
+  var_dump(vk_array_scale(['x' => 1.5, 'y' => 2.5], 2.0));
+}
+
+test_aggregates();
+test_element_wise();
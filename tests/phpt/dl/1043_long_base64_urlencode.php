@@ -0,0 +1,46 @@
+@ok
+<?php
+
+function make_bytes($len) {
+  $s = '';
+  for ($i = 0; $i < $len; $i++) {
+    $s .= chr(($i * 73 + 11) % 256);
+  }
+  return $s;
+}
+
+function test_base64() {
+  foreach ([0, 1, 2, 3, 11, 12, 13, 24, 27, 28, 29, 48, 100, 255, 1000] as $len) {
+    $s = make_bytes($len);
+    $encoded = base64_encode($s);
+    var_dump($encoded);
+    var_dump(base64_decode($encoded) === $s);
+    var_dump(base64_decode($encoded, true) === $s);
+    var_dump(base64_decode(rtrim($encoded, '='), true) === $s);
+    var_dump(base64_decode(chunk_split($encoded, 76, "\r\n"), true) === $s);
+    if ($len > 40) {
+      $broken = substr($encoded, 0, 37) . '*' . substr($encoded, 37);
+      var_dump(base64_decode($broken, true));
+      var_dump(base64_decode($broken) === $s);
+      $bad_padding = substr($encoded, 0, 20) . '=' . substr($encoded, 20);
+      var_dump(base64_decode($bad_padding, true));
+    }
+  }
+}
+
+function test_urlencode() {
+  $texts = [
+    str_repeat('abcdefghijklmnopqrstuvwxyz-ABCDEFGHIJKLMNOPQRSTUVWXYZ_0123456789.', 3),
+    str_repeat('key=value&other key=другое значение~', 5),
+    str_repeat('x', 31) . '/' . str_repeat('y', 33) . "\0" . str_repeat('z', 17),
+  ];
+  foreach ($texts as $text) {
+    var_dump(urlencode($text));
+    var_dump(rawurlencode($text));
+    var_dump(urldecode(urlencode($text)) === $text);
+    var_dump(rawurldecode(rawurlencode($text)) === $text);
+  }
+}
+
+test_base64();
+test_urlencode();
@@ -0,0 +1,63 @@
+@ok
+<?php
+
+interface Shape {
+  public function name(): string;
+  public function area(): float;
+}
+
+abstract class Polygon implements Shape {
+  public function name(): string { return "polygon"; }
+}
+
+class Rect extends Polygon {
+  public float $w = 2;
+  public float $h = 3;
+  public function area(): float { return $this->w * $this->h; }
+}
+
+class Square extends Rect {
+  public function name(): string { return "square"; }
+}
+
+class Triangle extends Polygon {
+  public function area(): float { return 0.5; }
+}
+
+class Hexagon extends Polygon {
+  public function area(): float { return 6.0; }
+}
+
+class Circle implements Shape {
+  public function name(): string { return "circle"; }
+  public function area(): float { return 3.14; }
+}
+
+function describe(Shape $s) {
+  var_dump($s->name(), $s->area());
+}
+
+function describe_polygon(Polygon $p) {
+  var_dump($p->name());
+}
+
+function describe_triangle(Triangle $t) {
+  // Polygon::name() is virtual, but for a Triangle it's always the same
+  var_dump($t->name(), $t->area());
+}
+
+function describe_hexagons(Hexagon ...$hexagons) {
+  foreach ($hexagons as $h) {
+    var_dump($h->name());
+  }
+}
+
+/** @var Shape[] $shapes */
+$shapes = [new Rect, new Square, new Triangle, new Hexagon, new Circle];
+foreach ($shapes as $s) {
+  describe($s);
+}
+describe_polygon(new Square);
+describe_polygon(new Hexagon);
+describe_triangle(new Triangle);
+describe_hexagons(new Hexagon, new Hexagon);
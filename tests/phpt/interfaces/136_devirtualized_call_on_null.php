@@ -0,0 +1,26 @@
+@kphp_runtime_should_warn
+/Critical error "call method\(Animal::name\) on null object"/
+<?php
+
+abstract class Animal {
+  public function name(): string { return "animal"; }
+}
+
+class Dog extends Animal {
+  public function name(): string { return "dog"; }
+}
+
+class Cat extends Animal {
+}
+
+/**
+ * @param ?Cat $cat
+ */
+function cat_name($cat) {
+  // Animal::name() is virtual, but for a Cat it's always Animal::name(), so the call is devirtualized
+  return $cat->name();
+}
+
+echo cat_name(new Cat), "\n";
+echo (new Dog)->name(), "\n";
+echo cat_name(null), "\n";
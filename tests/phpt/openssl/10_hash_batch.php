@@ -0,0 +1,70 @@
+@ok
+<?php
+#ifndef KPHP
+function md5_batch(array $strs, bool $raw_output = false) {
+  return array_map(function ($s) use ($raw_output) { return md5($s, $raw_output); }, $strs);
+}
+function sha1_batch(array $strs, bool $raw_output = false) {
+  return array_map(function ($s) use ($raw_output) { return sha1($s, $raw_output); }, $strs);
+}
+function crc32_batch(array $strs) {
+  return array_map('crc32', $strs);
+}
+function xxh3_64(string $s) {
+  return unpack('J', hash('xxh3', $s, true))[1];
+}
+#endif
+
+/**
+ * @return string[]
+ */
+function make_strings(int $count) {
+  $strs = [];
+  for ($i = 0; $i < $count; $i++) {
+    // the lengths cross the padding boundaries of md5 and sha1 blocks
+    $strs[] = str_repeat(chr(ord('a') + $i % 26), ($i * 7) % 150);
+  }
+  return $strs;
+}
+
+function test_batch_hashes() {
+  foreach ([0, 1, 3, 8, 9, 65, 200] as $count) {
+    $strs = make_strings($count);
+    $md5 = md5_batch($strs);
+    $md5_raw = md5_batch($strs, true);
+    $sha1 = sha1_batch($strs);
+    $sha1_raw = sha1_batch($strs, true);
+    $crc32 = crc32_batch($strs);
+    var_dump(count($md5) === $count && count($sha1) === $count && count($crc32) === $count);
+    foreach ($strs as $i => $s) {
+      if ($md5[$i] !== md5($s) || $md5_raw[$i] !== md5($s, true) ||
+          $sha1[$i] !== sha1($s) || $sha1_raw[$i] !== sha1($s, true) || $crc32[$i] !== crc32($s)) {
+        echo "mismatch at $i of $count\n";
+      }
+    }
+  }
+  var_dump(md5_batch(["", "abc"]));
+  var_dump(sha1_batch(["", "abc"]));
+  var_dump(crc32_batch(["", "abc"]));
+}
+
+function test_batch_keys() {
+  $strs = ["x" => "hello", 5 => "world", "y" => ""];
+  var_dump(md5_batch($strs));
+  var_dump(sha1_batch($strs));
+  var_dump(crc32_batch($strs));
+}
+
+function test_xxh3() {
+  foreach (["", "a", "abc", "12345678", str_repeat("x", 16), str_repeat("y", 100), str_repeat("z", 200), str_repeat("0123456789", 300)] as $s) {
+    var_dump(xxh3_64($s));
+    var_dump(hash('xxh3', $s));
+    var_dump(bin2hex(hash('xxh3', $s, true)));
+  }
+  var_dump(in_array('xxh3', hash_algos()));
+  var_dump(in_array('xxh3', hash_hmac_algos()));
+}
+
+test_batch_hashes();
+test_batch_keys();
+test_xxh3();
@@ -0,0 +1,56 @@
+@ok
+<?php
+
+class Row {
+  public $id = 0;
+  public $name = '';
+
+  public function __construct(int $id, string $name) {
+    $this->id = $id;
+    $this->name = $name;
+  }
+}
+
+function test_implode_in_loop() {
+  $rows = [new Row(1, 'a'), new Row(2, 'b'), new Row(3, 'c')];
+  $lines = [];
+  foreach ($rows as $row) {
+    $lines[] = implode(',', [$row->id, $row->name]);
+  }
+  var_dump($lines);
+}
+
+function test_different_sizes() {
+  $res = 0;
+  for ($i = 0; $i < 10; ++$i) {
+    $res += $i % 2 ? array_sum([$i, $i * 2, $i * 3]) : count([$i]);
+    $res += max([$i, 5]);
+  }
+  var_dump($res);
+}
+
+function test_in_array() {
+  $found = [];
+  for ($i = 0; $i < 10; ++$i) {
+    if (in_array($i, [2, $i % 3, 7])) {
+      $found[] = $i;
+    }
+  }
+  var_dump($found);
+}
+
+/** @var int[][] */
+$cache = [];
+
+function test_escaped_to_global() {
+  global $cache;
+  for ($i = 0; $i < 3; ++$i) {
+    $cache[] = array_values([$i, $i + 1]);
+  }
+  var_dump($cache);
+}
+
+test_implode_in_loop();
+test_different_sizes();
+test_in_array();
+test_escaped_to_global();
@@ -0,0 +1,138 @@
+@ok
+<?php
+
+class Config {
+  /** @var string[] */
+  public $data = ['key' => 'value', 'prefix' => 'p'];
+  public $counter = 0;
+
+  public function repeated() {
+    return $this->data['key'] . ':' . $this->data['key'] . ':' . strlen($this->data['key']);
+  }
+
+  public function modified_in_loop() {
+    $out = [];
+    for ($i = 0; $i < 3; ++$i) {
+      $out[] = $this->data['prefix'] . $i;
+      $this->data['prefix'] .= '!';
+    }
+    return $out;
+  }
+
+  public function bump() {
+    $this->counter++;
+    return $this->counter;
+  }
+}
+
+function test_count_in_condition() {
+  $arr = [1, 2, 3, 4];
+  $sum = 0;
+  for ($i = 0; $i < count($arr); ++$i) {
+    $sum += $arr[$i];
+  }
+  var_dump($sum);
+}
+
+function test_modified_array() {
+  $arr = [1, 2, 3];
+  $iterations = 0;
+  for ($i = 0; $i < count($arr) && $i < 10; ++$i) {
+    $arr[] = $i;
+    $iterations++;
+  }
+  var_dump($iterations);
+}
+
+function test_concat_prefix(string $a, string $b) {
+  $out = [];
+  foreach ([1, 2, 3] as $i) {
+    $out[] = "{$a}_{$b}_{$i}";
+    $out[] = $a . $b . $i;
+  }
+  var_dump($out);
+}
+
+function test_empty_loop(?array $maybe_null) {
+  $n = 0;
+  foreach ([] as $v) {
+    $n += count($maybe_null);
+  }
+  while (false) {
+    $n += strlen((string)$maybe_null[0]);
+  }
+  var_dump($n);
+}
+
+function test_cse(array $a, int $k) {
+  $x = $a[$k] . '/' . $a[$k];
+  $y = $k > 1 && $a[$k - 1] > 0 ? $a[$k - 1] : 0;
+  var_dump($x, $y);
+  var_dump(strlen($x) + strlen($x));
+}
+
+function test_impure_calls(Config $c) {
+  $r = $c->bump() + $c->bump();
+  var_dump($r);
+  while ($c->bump() < 5 && count($c->data) > 0) {
+    $c->data[] = 'x';
+  }
+  var_dump(count($c->data));
+}
+
+function test_nested_loops() {
+  $matrix = [[1, 2], [3, 4, 5], [6]];
+  $total = 0;
+  for ($i = 0; $i < count($matrix); ++$i) {
+    for ($j = 0; $j < count($matrix[$i]); ++$j) {
+      $total += $matrix[$i][$j];
+    }
+  }
+  var_dump($total);
+}
+
+/**
+ * @param int[] $opts
+ */
+function test_null_coalesce_in_condition($opts) {
+  $i = 0;
+  while ($i < ($opts['limit'] ?? 3)) {
+    ++$i;
+  }
+  var_dump($i);
+  $s = ($opts['limit'] ?? 5) + ($opts['limit'] ?? 5);
+  var_dump($s);
+}
+
+/**
+ * @param int[] $a
+ */
+function test_isset_in_condition($a) {
+  $n = 0;
+  while (isset($a['k']) && $n < 3) {
+    ++$n;
+  }
+  for ($i = 0; !isset($a['k']) && $i < 2 && empty($a['k']); ++$i) {
+    ++$n;
+  }
+  var_dump($n);
+  $x = isset($a['k']) ? $a['k'] : -1;
+  $y = empty($a['k']) ? 0 : $a['k'] + $a['k'];
+  var_dump($x, $y);
+}
+
+test_count_in_condition();
+test_modified_array();
+test_concat_prefix('x', 'y');
+test_empty_loop(null);
+test_cse([1, 2, 3, 4], 2);
+$c = new Config;
+var_dump($c->repeated());
+var_dump($c->modified_in_loop());
+test_impure_calls($c);
+test_nested_loops();
+test_null_coalesce_in_condition([]);
+test_null_coalesce_in_condition(['limit' => 2]);
+test_isset_in_condition([]);
+test_isset_in_condition(['k' => 4]);
+test_isset_in_condition(['k' => 0]);
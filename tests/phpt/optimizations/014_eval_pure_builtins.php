@@ -0,0 +1,47 @@
+@ok
+<?php
+
+class Consts {
+  const MAP = ['a' => 1, 'b' => 2, 'c' => '10', 5 => 'x'];
+  const NAMES = ['Foo', 'BAR', ' baz '];
+  const SALT = 'salt';
+}
+
+define('PREFIX', '  Hello World  ');
+
+function test_strings() {
+  var_dump(strtolower('CONST Ab'));
+  var_dump(strtoupper(Consts::NAMES[0]));
+  var_dump(ucfirst('abc'), lcfirst('ABC'), strrev('abc'));
+  var_dump(trim(PREFIX), ltrim(PREFIX), rtrim(PREFIX), trim('xxhixx', 'x'), trim("\0\t a \n"));
+  var_dump(str_repeat('ab', 3), str_repeat('ab', 0), str_repeat('', 1 << 62));
+  var_dump(strlen(PREFIX));
+}
+
+function test_hashes() {
+  var_dump(md5('salt'), md5(Consts::SALT, false), sha1('salt'), crc32('salt'));
+  var_dump(md5('salt', true) === md5('salt', true));
+}
+
+function test_arrays() {
+  var_dump(implode(',', ['a', 'b', 3]));
+  var_dump(implode(', ', Consts::NAMES));
+  var_dump(array_flip(Consts::MAP));
+  var_dump(array_flip(['1', '01', '-5', 'a', 'a']));
+  var_dump(array_flip(['1234567890123456789', '9223372036854775807', '9223372036854775808', '-9223372036854775808']));
+  var_dump(array_keys(Consts::MAP));
+  $flipped = array_flip(['x', 'y']);
+  $flipped['z'] = 'mixed value';
+  var_dump($flipped);
+}
+
+function test_in_expressions() {
+  $key = 'A';
+  var_dump(strtolower($key) . md5('x'));
+  var_dump(in_array('b', array_keys(Consts::MAP)));
+}
+
+test_strings();
+test_hashes();
+test_arrays();
+test_in_expressions();
@@ -0,0 +1,89 @@
+@ok
+<?php
+
+function test_appends() {
+  $ids = [];
+  for ($i = 0; $i < 5; ++$i) {
+    $ids[] = $i * 10;
+  }
+  foreach ($ids as $k => $id) {
+    var_dump($k, $id);
+  }
+  var_dump($ids[2], $ids[4]);
+}
+
+function test_literals_and_builtins(string $s) {
+  $words = explode(',', $s);
+  $copy = $words;
+  $copy[] = 'tail';
+  foreach ($copy as $i => $w) {
+    echo "$i: $w\n";
+  }
+  $values = array_values(['a' => 1, 'b' => 2]);
+  $values = [3, 4, 5];
+  foreach ($values as $v) {
+    var_dump($v);
+  }
+}
+
+function test_not_lists() {
+  $map = [1, 2, 3];
+  unset($map[1]);
+  foreach ($map as $k => $v) {
+    var_dump($k, $v);
+  }
+
+  $keyed = [];
+  $keyed[5] = 'x';
+  $keyed[] = 'y';
+  foreach ($keyed as $k => $v) {
+    var_dump($k, $v);
+  }
+
+  $sorted = [3, 1, 2];
+  sort($sorted);
+  foreach ($sorted as $k => $v) {
+    var_dump($k, $v);
+  }
+
+  $from_map = ['x' => 1];
+  $chain = $from_map;
+  foreach ($chain as $k => $v) {
+    var_dump($k, $v);
+  }
+}
+
+function test_modified_while_iterating() {
+  $list = [1, 2, 3];
+  foreach ($list as $i => $v) {
+    $list[] = $v + $i;
+  }
+  var_dump($list);
+}
+
+function test_empty() {
+  /** @var string[] $empty */
+  $empty = [];
+  foreach ($empty as $k => $v) {
+    var_dump($k, $v);
+  }
+  var_dump(count($empty));
+}
+
+/**
+ * @param int|false $pos
+ * @param ?int $maybe_index
+ */
+function test_optional_keys(string $s, $pos, $maybe_index) {
+  $words = explode(',', $s);
+  $words[] = 'd';
+  echo $words[$pos], "|", $words[$maybe_index], "\n";
+}
+
+test_appends();
+test_literals_and_builtins('a,b,c');
+test_not_lists();
+test_modified_while_iterating();
+test_empty();
+test_optional_keys('a,b,c', 2, 1);
+test_optional_keys('a,b,c', false, null);
@@ -0,0 +1,49 @@
+@ok
+<?php
+
+function make_rows() {
+  $rows = [];
+  for ($i = 0; $i < 3; ++$i) {
+    $rows[] = $i;
+  }
+  return $rows;
+}
+
+function test_rows_in_loop() {
+  $out = [];
+  foreach (make_rows() as $i) {
+    $row = ['id' => $i, 'name' => "name$i", 'score' => $i * 1.5];
+    $out[] = $row['id'] . ':' . $row['name'] . ':' . $row['score'];
+  }
+  var_dump($out);
+}
+
+function test_nested(int $x) {
+  $cfg = ['limits' => [$x, $x + 1], 'title' => 'cfg'];
+  var_dump($cfg['limits'][1], $cfg['title']);
+}
+
+function test_escaping(int $x) {
+  $passed = ['a' => $x];
+  var_dump($passed);
+
+  $written = ['a' => $x];
+  $written['b'] = 2;
+  var_dump($written['a']);
+
+  $checked = ['a' => $x];
+  var_dump(isset($checked['a']));
+
+  $reassigned = ['a' => $x];
+  $reassigned = ['a' => $x + 1];
+  var_dump($reassigned['a']);
+
+  if ($x > 100) {
+    $conditional = ['a' => $x];
+  }
+  var_dump(isset($conditional));
+}
+
+test_rows_in_loop();
+test_nested(10);
+test_escaping(5);
@@ -0,0 +1,58 @@
+@ok
+<?php
+
+function test_conversions(string $line) {
+  $id = (int)explode(',', $line)[0];
+  $flag = (bool)explode(',', $line)[2];
+  var_dump($id, $flag);
+  if (explode(',', $line)[1]) {
+    echo "non-empty\n";
+  }
+}
+
+function test_concat_and_append(string $line, string $delim) {
+  $s = 'prefix:';
+  $s .= explode($delim, $line)[1];
+  $s = $s . '|' . explode($delim, $line)[0] . '|';
+  var_dump($s);
+}
+
+function test_array_keys(string $line) {
+  $counts = ['a' => 0, 'b' => 0, '1' => 0];
+  $counts[explode(' ', $line)[0]] = 10;
+  $counts[explode(' ', $line)[1]] += 5;
+  var_dump($counts);
+}
+
+function test_readonly_params(string $line) {
+  var_dump(trim(explode(';', $line)[1]));
+  var_dump(substr(explode(';', $line)[0], 1, 3));
+  var_dump(explode('=', explode(';', $line)[2])[1]);
+  var_dump(explode(';', substr($line, 2))[0]);
+  var_dump(explode(';', trim($line))[3]);
+}
+
+function test_whole_string(string $line) {
+  $copy = explode('|', $line)[0];
+  var_dump($copy, $copy === $line);
+}
+
+function test_substr_with_long_delimiter(string $line) {
+  // the delimiter straddles the end of the substr() view, it must not be matched
+  var_dump(explode('ab', substr($line, 0, 3))[0]);
+  var_dump(explode('ab', substr($line, 0, 3))[1] ?? 'none');
+  var_dump(explode('ab', substr($line, 0, 4))[1]);
+  var_dump(explode('::', substr($line, 2, 5))[1] ?? 'none');
+  var_dump(explode('abab', substr($line, 1))[0]);
+}
+
+test_conversions('123,,1');
+test_conversions('-7,x,0');
+test_concat_and_append('one two three', ' ');
+test_concat_and_append('single', 'single');
+test_array_keys('a b');
+test_array_keys('1 a');
+test_readonly_params('abcdef;  padded  ;key=value; last ');
+test_whole_string('no delimiters here');
+test_substr_with_long_delimiter('xxab::cd');
+test_substr_with_long_delimiter('xaba');
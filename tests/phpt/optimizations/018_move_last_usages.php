@@ -0,0 +1,172 @@
+@ok
+<?php
+
+/**
+ * @param int[] $arr
+ * @return int[]
+ */
+function append_one(array $arr, int $value) {
+  $arr[] = $value;
+  return $arr;
+}
+
+function append_str(string $s, string $suffix): string {
+  $s .= $suffix;
+  return $s;
+}
+
+class Holder {
+  /** @var int[] */
+  public $items = [];
+  /** @var mixed */
+  public $value = null;
+
+  /**
+   * @param int[] $items
+   */
+  public function set_items(array $items) {
+    $this->items = $items;
+  }
+
+  /**
+   * @param int[] $items
+   * @return int[]
+   */
+  public function store_and_return(array $items) {
+    $this->items = $items;
+    return $items;
+  }
+
+  /**
+   * @param int[] $items
+   * @return mixed
+   */
+  public function store_and_return_mixed(array $items) {
+    $this->items = $items;
+    return $items;
+  }
+}
+
+function test_overwrite_in_loops() {
+  $arr = [];
+  $copy = [];
+  for ($i = 0; $i < 5; ++$i) {
+    $arr = append_one($arr, $i);
+    if ($i == 2) {
+      $copy = $arr;
+    }
+  }
+  var_dump($arr, $copy);
+
+  $s = "";
+  $prefix = "";
+  foreach (["a", "b", "c"] as $c) {
+    $s = append_str($s, $c);
+    $prefix = $s;
+  }
+  $i = 0;
+  while ($i < 3) {
+    $s = append_str($s, (string)$i);
+    ++$i;
+  }
+  var_dump($s, $prefix);
+}
+
+function test_move_into_field_and_alias() {
+  $items = [1, 2, 3];
+  $alias = $items;
+  $holder = new Holder;
+  $holder->items = $items;
+  $holder->items[] = 4;
+  $alias[] = 5;
+  var_dump($holder->items, $alias);
+
+  $other = [10, 20];
+  $other_alias = $other;
+  $holder->set_items($other);
+  $holder->items[0] = 11;
+  var_dump($holder->items, $other_alias);
+
+  /** @var mixed $m */
+  $m = [1, 'a'];
+  $m_alias = $m;
+  $holder->value = $m;
+  $holder->value[] = 'b';
+  var_dump($holder->value, $m_alias);
+}
+
+function test_return_param_stored_in_field() {
+  $holder = new Holder;
+  $returned = $holder->store_and_return([7, 8]);
+  $returned[] = 9;
+  var_dump($returned, $holder->items);
+
+  $returned_mixed = $holder->store_and_return_mixed([1, 2]);
+  $returned_mixed[] = 3;
+  var_dump($returned_mixed, $holder->items);
+}
+
+function throw_if(bool $cond) {
+  if ($cond) {
+    throw new Exception("thrown");
+  }
+}
+
+/**
+ * @param int[] $arr
+ * @return int[]
+ */
+function append_or_throw(array $arr, bool $cond) {
+  $arr[] = 100;
+  throw_if($cond);
+  return $arr;
+}
+
+function test_used_after_try_catch() {
+  $arr = [1, 2];
+  try {
+    $arr = append_or_throw($arr, true);
+  } catch (Exception $e) {
+    echo $e->getMessage(), "\n";
+  }
+  var_dump($arr);
+
+  $holder = new Holder;
+  $items = [3, 4];
+  try {
+    throw_if(false);
+    $holder->items = $items;
+  } catch (Exception $e) {
+    echo "unreachable\n";
+  }
+  $items[] = 5;
+  var_dump($holder->items, $items);
+}
+
+function test_captured_after_move() {
+  $holder = new Holder;
+  $items = [1, 2, 3];
+  $holder->items = append_one($items, 4);
+  $get_count = function() use ($items) {
+    return count($items);
+  };
+  var_dump($get_count(), $holder->items);
+
+  $str = "abc";
+  $holder->value = $str;
+  $get_str = fn() => $str . "!";
+  var_dump($get_str(), $holder->value);
+
+  $arr = [5];
+  $arr = append_one($arr, 6);
+  $sum = function() use ($arr) {
+    return array_sum($arr);
+  };
+  var_dump($sum(), $arr);
+}
+
+test_overwrite_in_loops();
+test_move_into_field_and_alias();
+test_return_param_stored_in_field();
+test_used_after_try_catch();
+test_captured_after_move();
@@ -0,0 +1,59 @@
+@kphp_runtime_should_warn
+/count\(\): Parameter is string, but an array expected/
+/count\(\): Parameter is boolean, but an array expected/
+!/count\(\): Parameter is NULL, but an array expected/
+!/count\(\): Parameter is double, but an array expected/
+<?php
+
+/**
+ * @param mixed $s
+ */
+function test_repeated_in_statement($s) {
+  // count($s) is computed once, the warning is emitted once instead of twice
+  $n = count($s) + count($s);
+  var_dump($n);
+}
+
+/**
+ * @param mixed $b
+ */
+function test_hoisted_from_loop_condition($b) {
+  // a loop condition is evaluated at least once: count($b) is hoisted, and the warning is emitted once
+  $i = 0;
+  while ($i < count($b) + 2) {
+    ++$i;
+  }
+  var_dump($i);
+}
+
+/**
+ * @param mixed $n
+ */
+function test_not_hoisted_from_loop_body($n) {
+  // the body is not executed, so count($n) must not be evaluated speculatively
+  $sum = 0;
+  foreach ([] as $_) {
+    $sum += count($n);
+  }
+  for ($i = 0; $i < 0; ++$i) {
+    $sum += count($n) + count($n);
+  }
+  var_dump($sum);
+}
+
+/**
+ * @param mixed $f
+ */
+function test_not_reused_under_conditions(bool $flag, $f) {
+  // both count($f) are evaluated only if $flag is true
+  $x = $flag && count($f) > 0 && count($f) < 5;
+  var_dump($x);
+  $y = $flag ? count($f) : 0;
+  $z = $y ?: ($flag ? count($f) : -1);
+  var_dump($y, $z);
+}
+
+test_repeated_in_statement('str');
+test_hoisted_from_loop_condition(true);
+test_not_hoisted_from_loop_body(null);
+test_not_reused_under_conditions(false, 1.5);
@@ -0,0 +1,60 @@
+@ok
+<?php
+
+// count(), sizeof(), strlen(), in_array() and array_key_exists() are @kphp-pure-function:
+// being called with constant arguments, they are extracted into constants, initialized once
+
+class Limits {
+  const SIZES = [10, 20, 30];
+  const NAMES = ['small' => 's', 'medium' => 'm', 'large' => 'l'];
+  const NESTED = [[1, 2], [3], []];
+  const TITLE = 'limits';
+}
+
+define('GREETING', 'hello');
+define('EMPTY_LIST', []);
+const PAIRS = ['a' => [1, 2], 'b' => [3, 4]];
+
+function test_count() {
+  var_dump(count(Limits::SIZES), sizeof(Limits::NAMES), count(EMPTY_LIST), count(PAIRS));
+  var_dump(count(Limits::NESTED[0]), count(PAIRS['b']), count([1, 2, 3]));
+  var_dump(count(Limits::SIZES) * 2 + sizeof(Limits::NESTED));
+}
+
+function test_strlen() {
+  var_dump(strlen(GREETING), strlen(Limits::TITLE), strlen(''), strlen(Limits::NAMES['small']));
+  var_dump(strlen(GREETING . ' ' . Limits::TITLE), strlen("a\0b"));
+}
+
+function test_in_array_and_key_exists() {
+  var_dump(in_array(20, Limits::SIZES), in_array('20', Limits::SIZES), in_array('20', Limits::SIZES, true));
+  var_dump(in_array('m', Limits::NAMES), in_array(0, EMPTY_LIST), in_array('x', Limits::NAMES));
+  var_dump(array_key_exists('medium', Limits::NAMES), array_key_exists(1, Limits::SIZES), array_key_exists(3, Limits::SIZES));
+  var_dump(array_key_exists('c', PAIRS), array_key_exists(0, Limits::NESTED[1]));
+}
+
+function test_in_loops() {
+  $total = 0;
+  for ($i = 0; $i < count(Limits::SIZES); ++$i) {
+    $total += Limits::SIZES[$i] * strlen(GREETING);
+  }
+  foreach (Limits::NAMES as $name => $short) {
+    if (in_array($short, ['s', 'l']) && array_key_exists($name, Limits::NAMES)) {
+      $total += strlen($name);
+    }
+  }
+  var_dump($total);
+}
+
+function test_static_and_default(int $mult = 2) {
+  static $calls = 0;
+  $calls += count(Limits::SIZES);
+  var_dump($calls * $mult);
+}
+
+test_count();
+test_strlen();
+test_in_array_and_key_exists();
+test_in_loops();
+test_static_and_default();
+test_static_and_default(3);
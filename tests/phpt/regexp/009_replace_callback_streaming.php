@@ -0,0 +1,76 @@
+@ok
+<?php
+
+function test_replacement_templates() {
+  $subject = "john.smith@example.com, jane@test.org";
+  foreach (['<$0>', '\1 at ${2}', '$11|$1\1|\\\\|\$1|${1}x|${12}|$', '[${1', 'plain', ''] as $replacement) {
+    var_dump(preg_replace('/(\w+)@(\w+)/', $replacement, $subject));
+  }
+  var_dump(preg_replace('/a/', 'b', 'aaaa', 2));
+  var_dump(preg_replace('/x*/', '-', 'abc'));
+  var_dump(preg_replace('/x*/u', '-', 'бук'));
+}
+
+function test_callback_keeps_matches() {
+  $kept = [];
+  $result = preg_replace_callback('/(\d)(\w)?/', function ($m) use (&$kept) {
+    $kept[] = $m;
+    return strtoupper($m[0]);
+  }, "1a 2b 3 4c 5");
+  var_dump($result);
+  var_dump($kept);
+
+  $first_groups = [];
+  $result = preg_replace_callback('/(\w)\w*/', function ($m) use (&$first_groups) {
+    $first_groups[] = $m[1];
+    return $m[1];
+  }, "hello big world");
+  var_dump($result);
+  var_dump($first_groups);
+}
+
+function test_callback_named_groups() {
+  $result = preg_replace_callback('/(?<key>\w+)=(?<value>\w+)?/', function ($m) {
+    var_dump($m);
+    return $m['key'] . ':' . ($m['value'] ?? 'none');
+  }, "a=1&b=&c=3");
+  var_dump($result);
+}
+
+function test_nested_regexps() {
+  $result = preg_replace_callback('/\[(\w+)\]/', function ($m) {
+    $inner = preg_replace_callback('/[aeiou]/', function ($v) { return strtoupper($v[0]); }, $m[1]);
+    $parts = preg_split('/a/', $m[1]);
+    return $inner . count($parts);
+  }, "[banana] and [kiwi] and [apple]", -1, $count);
+  var_dump($result, $count);
+}
+
+function test_split() {
+  $subject = "one, two,,three , four";
+  var_dump(preg_split('/\s*,\s*/', $subject));
+  var_dump(preg_split('/\s*,\s*/', $subject, 2));
+  var_dump(preg_split('/\s*,\s*/', $subject, 1));
+  var_dump(preg_split('/\s*(,)\s*/', $subject, -1, PREG_SPLIT_DELIM_CAPTURE | PREG_SPLIT_NO_EMPTY));
+  var_dump(preg_split('/\s*,\s*/', $subject, -1, PREG_SPLIT_OFFSET_CAPTURE));
+  var_dump(preg_split('//', 'abc', -1, PREG_SPLIT_NO_EMPTY));
+  var_dump(preg_split('//u', 'эюя', -1, PREG_SPLIT_NO_EMPTY));
+}
+
+function test_long_document() {
+  $doc = str_repeat("id=12345; name=John; ", 2000);
+  $total = 0;
+  $result = preg_replace_callback('/(\w+)=(\w+)/', function ($m) use (&$total) {
+    $total += strlen($m[2]);
+    return $m[2];
+  }, $doc);
+  var_dump(strlen($result), $total, md5($result));
+  var_dump(count(preg_split('/;\s*/', $doc, -1, PREG_SPLIT_NO_EMPTY)));
+}
+
+test_replacement_templates();
+test_callback_keeps_matches();
+test_callback_named_groups();
+test_nested_regexps();
+test_split();
+test_long_document();
@@ -0,0 +1,59 @@
+@ok
+<?php
+#ifndef KPHP
+function preg_match_set(array $patterns, string $subject) {
+  $result = [];
+  $position = 0;
+  foreach ($patterns as $pattern) {
+    if (preg_match($pattern, $subject)) {
+      $result[] = $position;
+    }
+    $position++;
+  }
+  return $result;
+}
+#endif
+
+function test_router() {
+  $routes = [
+    '~^/api/v\d+/users/\d+$~',
+    '~^/api/v\d+/users$~',
+    '#^/static/#',
+    '/\.(jpg|png|gif)$/i',
+    '/^\/admin(\/|$)/',
+    '/(?<=\/)private/',        // lookbehind: not supported by RE2
+    '/^\/api\/v(\d)\/.*\1$/',  // backreference: not supported by RE2
+    '/^\/API/i',
+    '/a.b/s',
+    '/^$/m',
+  ];
+  foreach (['/api/v2/users/42', '/api/v1/users', '/static/img/logo.PNG', '/admin', '/admin/x', '/user/private',
+            '/api/v3/path/3', "/x\nb", "a\nb", '', '/API/V1'] as $path) {
+    var_dump(preg_match_set($routes, $path));
+    // the second call is served by the cached set
+    var_dump(preg_match_set($routes, $path));
+  }
+}
+
+function test_utf8() {
+  $patterns = ['/привет/u', '/^\w+$/u', '/мир/', '/^.{3}$/u', '/^.{6}$/'];
+  foreach (['привет', 'мир', "\xff\xfe", 'abc'] as $subject) {
+    var_dump(preg_match_set($patterns, $subject));
+  }
+}
+
+function test_edge_cases() {
+  var_dump(preg_match_set([], 'anything'));
+  var_dump(preg_match_set(['/a/'], ''));
+  var_dump(preg_match_set(['x' => '/a/', 'y' => '/b/', 'z' => '/c/'], 'cab'));
+
+  $many = [];
+  for ($i = 0; $i < 100; $i++) {
+    $many[] = "/word$i\\b/";
+  }
+  var_dump(preg_match_set($many, 'word7 word42 word99 word100'));
+}
+
+test_router();
+test_utf8();
+test_edge_cases();
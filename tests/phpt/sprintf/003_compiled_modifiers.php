@@ -0,0 +1,51 @@
+@ok
+<?php
+
+function get_int(int $x): int {
+  echo "get_int($x)\n";
+  return $x;
+}
+
+function test_ints() {
+  foreach ([0, 7, -7, 255, 123456789, PHP_INT_MAX] as $i) {
+    echo sprintf("[%5d] [%-5d] [%'*8d] [%+d] [%+-6d]\n", $i, $i, $i, $i, $i);
+    echo sprintf("[%x] [%X] [%08x] [%b] [%o] [%u]\n", $i, $i, $i, $i, $i, $i);
+  }
+  foreach ([0, 42, 100500] as $i) {
+    echo sprintf("[%05d] [%'010u]\n", $i, $i);
+  }
+  $mixed = ["12abc", 3.99, true, null];
+  foreach ($mixed as $m) {
+    echo sprintf("%3d|%x|%02u\n", $m, $m, $m);
+  }
+}
+
+function test_floats() {
+  foreach ([0.0, 1.5, -2.25, 3.14159265358979, 1e10, 0.3] as $f) {
+    echo sprintf("[%f] [%.2f] [%10.3f] [%-10.1f] [%+.1F]\n", $f, $f, $f, $f, $f);
+  }
+  foreach ([0.0, 2.5, 3.14159265358979] as $f) {
+    echo sprintf("[%010.2f] [%'#12.4F]\n", $f, $f);
+  }
+  echo sprintf("%.2f%%\n", "42.456");
+}
+
+function test_strings() {
+  foreach (["", "a", "hello", "hello world", "привет"] as $s) {
+    echo sprintf("[%8s] [%-8s] [%'.8s] [%.3s] [%-6.2s]\n", $s, $s, $s, $s, $s);
+  }
+  echo sprintf("[%5s] [%-5s]\n", 12, 3.5);
+}
+
+function test_positional_and_percents() {
+  echo sprintf("%2\$s %1\$s\n", "world", "hello");
+  echo sprintf("%1\$05d-%1\$x\n", 255);
+  echo sprintf("[%%] [%d%%]\n", 50);
+  echo sprintf("%d %05d %s\n", get_int(1), get_int(2), get_int(3));
+  echo vsprintf("%04d-%02d-%02d\n", [2023, 5, 7]);
+}
+
+test_ints();
+test_floats();
+test_strings();
+test_positional_and_percents();
@@ -0,0 +1,52 @@
+@ok
+<?php
+
+function get_value(string $value): string {
+  echo "get_value($value)\n";
+  return $value;
+}
+
+// the format is not a compile-time constant, so sprintf() is not compiled
+function runtime_format(string $format): string {
+  return $format;
+}
+
+function test_argument_evaluations() {
+  echo sprintf("%2\$s\n", get_value("a"), get_value("b"));
+  echo sprintf("%2\$s %1\$s\n", get_value("c"), get_value("d"));
+  echo sprintf("%1\$s %1\$s\n", get_value("e"));
+  echo sprintf("%s\n", get_value("f"), get_value("g"));
+  echo sprintf("no specifiers\n", get_value("h"));
+  $x = "x";
+  $y = "y";
+  echo sprintf("%2\$s %1\$s %2\$s\n", $x, $y);
+}
+
+function test_positional() {
+  $s = "str";
+  $i = 42;
+  var_dump(sprintf("%2\$05d|%1\$s|%2\$x", $s, $i) === sprintf(runtime_format("%2\$05d|%1\$s|%2\$x"), $s, $i));
+  var_dump(sprintf("%1\$'*8.2s|%1\$-6.1s", $s) === sprintf(runtime_format("%1\$'*8.2s|%1\$-6.1s"), $s));
+}
+
+function test_width_and_precision() {
+  foreach (["", "a", "hello", "hello world", "привет"] as $s) {
+    var_dump(sprintf("[%8.3s] [%-8.2s] [%'.8.10s] [%.0s] [%5s] [%-5s]", $s, $s, $s, $s, $s, $s) ===
+             sprintf(runtime_format("[%8.3s] [%-8.2s] [%'.8.10s] [%.0s] [%5s] [%-5s]"), $s, $s, $s, $s, $s, $s));
+  }
+  foreach ([0, -7, 255, PHP_INT_MAX] as $i) {
+    var_dump(sprintf("[%5d] [%-5d] [%'*8x] [%+d] [%010.3f]", $i, $i, $i, $i, $i) ===
+             sprintf(runtime_format("[%5d] [%-5d] [%'*8x] [%+d] [%010.3f]"), $i, $i, $i, $i, $i));
+  }
+}
+
+function test_embedded_zero() {
+  foreach (["ab\0cd", "\0abc", "abc\0"] as $s) {
+    var_dump(sprintf("[%.10s] [%8.2s] [%-8.4s]", $s, $s, $s) === sprintf(runtime_format("[%.10s] [%8.2s] [%-8.4s]"), $s, $s, $s));
+  }
+}
+
+test_argument_evaluations();
+test_positional();
+test_width_and_precision();
+test_embedded_zero();
@@ -0,0 +1,41 @@
+<?php
+
+function read_in_fork(string $name) {
+  $content = file_get_contents_concurrently($name);
+  sched_yield();
+  return $content;
+}
+
+function test_file_io_concurrently() {
+  $params = json_decode(file_get_contents('php://input'));
+  $name = (string)$params["name"];
+  $content = str_repeat((string)$params["content"], (int)$params["repeat"]);
+
+  $written = file_put_contents_concurrently($name, $content);
+  $appended = file_put_contents_concurrently($name, "tail", FILE_APPEND);
+
+  $futures = [];
+  for ($i = 0; $i < 4; ++$i) {
+    $futures[] = fork(read_in_fork($name));
+  }
+  $reads = wait_multi($futures);
+  $fork_stat = get_fork_stat($futures[0]);
+
+  echo json_encode([
+    "written" => $written,
+    "appended" => $appended,
+    "reads_match" => count(array_unique($reads)) === 1 && $reads[0] === $content . "tail",
+    "missing_file" => file_get_contents_concurrently($name . ".missing"),
+    "has_fork_wait_time" => is_array($fork_stat) && $fork_stat["file_io_wait_time"] >= 0,
+    "has_script_wait_time" => get_file_io_wait_time() > 0,
+  ]);
+}
+
+switch ($_SERVER["PHP_SELF"]) {
+  case "/test_file_io_concurrently": {
+    test_file_io_concurrently();
+    return;
+  }
+}
+
+critical_error("unknown test");
@@ -0,0 +1,36 @@
+from python.lib.testcase import KphpServerAutoTestCase
+
+
+class TestFileIoConcurrently(KphpServerAutoTestCase):
+    def _file_io_request(self, name, content, repeat):
+        resp = self.kphp_server.http_post(
+            uri="/test_file_io_concurrently",
+            json={
+                "name": name,
+                "content": content,
+                "repeat": repeat
+            })
+        self.assertEqual(resp.status_code, 200)
+        return resp.json()
+
+    def _expected(self, written):
+        return {
+            "written": written,
+            "appended": 4,
+            "reads_match": True,
+            "missing_file": False,
+            "has_fork_wait_time": True,
+            "has_script_wait_time": True,
+        }
+
+    def test_small_file(self):
+        self.assertEqual(self._file_io_request("small_file.txt", "hello", 1), self._expected(5))
+
+    def test_large_file(self):
+        self.assertEqual(self._file_io_request("large_file.txt", "0123456789abcdef", 1 << 16), self._expected(16 << 16))
+
+    def test_empty_file(self):
+        self.assertEqual(self._file_io_request("empty_file.txt", "", 1), self._expected(0))
+
+    def test_file_wrapper_prefix(self):
+        self.assertEqual(self._file_io_request("file://prefixed_file.txt", "abc", 3), self._expected(9))
@@ -0,0 +1,63 @@
+<?php
+
+// within the default budget, it's inline regardless of the call sites
+function small_in_default_budget(int $a, int $b): int {
+  return $a + $b + 1;
+}
+
+// too big for the default budget, but it's called only once
+function called_once_medium(int $x): int {
+  $y = $x * 3 + 1;
+  if ($y % 2 == 0) {
+    return ($y >> 1) + $x - 1;
+  }
+  return $y * 2 - $x + 7;
+}
+
+// too big for any budget, and it's called from several places
+function too_big_many_calls(int $x): int {
+  $y = $x * 3 + 1;
+  $z = $y * $y - $x;
+  if ($z % 2 == 0) {
+    $z = ($z >> 1) + $y * 5 - $x * 7;
+  } else {
+    $z = $z * 3 + $y * 11 - $x * 13;
+  }
+  if ($z % 3 == 0) {
+    return $z - $y + $x * 2;
+  }
+  return $z + $y - $x * 4;
+}
+
+// it's called only once from outside, but a recursive function gets only the default budget
+function recursive_called_once(int $n): int {
+  if ($n <= 1) {
+    return 1;
+  }
+  return $n * recursive_called_once($n - 1) % 1000 + $n % 3 - 1;
+}
+
+// static vars are never inlined
+function with_static_var(): int {
+  static $calls = 0;
+  $calls++;
+  return $calls;
+}
+
+function with_ref_param(int &$x) {
+  $x = $x * 2 + 1;
+}
+
+function main() {
+  echo called_once_medium(5), "\n";
+  echo small_in_default_budget(1, 2), " ", small_in_default_budget(3, 4), " ", small_in_default_budget(5, 6), "\n";
+  echo too_big_many_calls(1), " ", too_big_many_calls(2), " ", too_big_many_calls(3), "\n";
+  echo recursive_called_once(10), "\n";
+  echo with_static_var(), " ", with_static_var(), " ", with_static_var(), "\n";
+  $v = 1;
+  with_ref_param($v);
+  with_ref_param($v);
+  echo $v, "\n";
+}
+
+main();
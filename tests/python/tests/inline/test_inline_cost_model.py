@@ -0,0 +1,35 @@
+import glob
+import os
+import re
+
+from python.lib.testcase import KphpCompilerAutoTestCase
+
+
+class TestInlineCostModel(KphpCompilerAutoTestCase):
+    def _is_inline(self, cpp_dir, function_name):
+        # an inline function is generated only into its header, the other functions have their own .cpp
+        headers = glob.glob(os.path.join(cpp_dir, "**", function_name + ".h"), recursive=True)
+        self.assertEqual(len(headers), 1, "Can't find the header of {}".format(function_name))
+        sources = glob.glob(os.path.join(cpp_dir, "**", function_name + ".cpp"), recursive=True)
+        return len(sources) == 0
+
+    def test_inline_by_cost_model(self):
+        metrics_file = os.path.join(self.kphp_build_working_dir, "compilation_metrics.txt")
+        once_runner = self.build_and_compare_with_php("php/index.php", kphp_env={
+            "KPHP_PROFILER": "0",
+            "KPHP_COMPILATION_METRICS_FILE": metrics_file,
+        })
+        cpp_dir = os.path.join(os.path.dirname(once_runner.kphp_runtime_bin), "kphp")
+
+        self.assertTrue(self._is_inline(cpp_dir, "small_in_default_budget"))
+        self.assertTrue(self._is_inline(cpp_dir, "called_once_medium"))
+        self.assertTrue(self._is_inline(cpp_dir, "with_ref_param"))
+        self.assertFalse(self._is_inline(cpp_dir, "too_big_many_calls"))
+        self.assertFalse(self._is_inline(cpp_dir, "recursive_called_once"))
+        self.assertFalse(self._is_inline(cpp_dir, "with_static_var"))
+
+        with open(metrics_file) as f:
+            metrics = f.read()
+        inline_by_cost_model = re.search(r"^functions\.inline_by_cost_model: (\d+)$", metrics, re.MULTILINE)
+        self.assertIsNotNone(inline_by_cost_model)
+        self.assertGreaterEqual(int(inline_by_cost_model.group(1)), 1)
@@ -12,6 +12,8 @@
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
+#include <string>
+#include <unordered_map>
 
 #include "common/algorithms/find.h"
 #include "common/c-tree.h"
@@ -522,12 +524,20 @@ static void get_php_class_name(char *dst, struct tl_tree_type *tree, int num) {
   }
 }
 
+// in typed mode every stored or fetched TL object needs its PHP class resolved (by name on fetching, to the combinator name on storing);
+// the results are memoized till the end of the request, as user class entries don't outlive it
+static std::unordered_map<std::string, zend_class_entry *> php_class_by_name;
+static std::unordered_map<const zend_class_entry *, std::string> combinator_name_by_php_class;
+
 static zval *create_php_instance(const char *class_name) {
   //fprintf(stderr, "creating instance of class %s\n", class_name);
   zval *ci;
   VK_ALLOC_INIT_ZVAL (ci);
-  zend_class_entry *ce = vk_get_class(class_name);
-  object_init_ex(ci, ce);
+  auto it = php_class_by_name.find(class_name);
+  if (it == php_class_by_name.end()) {
+    it = php_class_by_name.emplace(class_name, vk_get_class(class_name)).first;
+  }
+  object_init_ex(ci, it->second);
   return ci;
 }
 
@@ -598,13 +608,18 @@ VK_ZVAL_API_P get_field(zval *arr, const char *id, int num, zval **dst) {
         break;
       case IS_OBJECT:
         if (!strcmp(id, "_")) {
-          char php_class_name[PHP_CLASS_NAME_BUFFER_LENGTH];
-          vk_get_class_name(arr, php_class_name);
-          char current_combinator_name[PHP_CLASS_NAME_BUFFER_LENGTH];
-          get_current_combinator_name(current_combinator_name, php_class_name);
-          //fprintf(stderr, "got _ = %s\n", current_combinator_name);
+          const zend_class_entry *ce = Z_OBJCE_P(arr);
+          auto it = combinator_name_by_php_class.find(ce);
+          if (it == combinator_name_by_php_class.end()) {
+            char php_class_name[PHP_CLASS_NAME_BUFFER_LENGTH];
+            vk_get_class_name(arr, php_class_name);
+            char current_combinator_name[PHP_CLASS_NAME_BUFFER_LENGTH];
+            get_current_combinator_name(current_combinator_name, php_class_name);
+            it = combinator_name_by_php_class.emplace(ce, current_combinator_name).first;
+          }
+          //fprintf(stderr, "got _ = %s\n", it->second.c_str());
           VK_ALLOC_INIT_ZVAL(*dst);
-          VK_ZVAL_STRING_DUP(*dst, current_combinator_name);
+          VK_ZVAL_STRING_DUP(*dst, it->second.c_str());
           //fprintf(stderr, "######### %s\n", current_combinator_name);
         } else {
           //fprintf(stderr, "reading instance property %s\n", id);
@@ -903,6 +918,8 @@ void tl_parse_on_rshutdown() {
     }
     last_var_ptr++;
   }
+  php_class_by_name.clear();
+  combinator_name_by_php_class.clear();
 }
 
 #define MAX_SIZE 100000